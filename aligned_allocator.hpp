@@ -0,0 +1,135 @@
+#ifndef BOOST_CONTAINER_CONTAINER_ALIGNED_ALLOCATOR_HPP
+#define BOOST_CONTAINER_CONTAINER_ALIGNED_ALLOCATOR_HPP
+
+/*
+  Over-aligned allocator for SIMD friendly buffers
+
+  aligned_allocator<T, Align> returns buffers that:
+     + start on an Align byte boundary (Align must be a power of two, it defaults to a cache line)
+     + have their size rounded up to a multiple of Align bytes, so a full width (Align byte) aligned load
+       that starts before the end of the last element never reads past the allocation.
+  With a 32 or 64 byte Align, SIMD kernels can therefore run over the whole of data() with aligned loads and
+  without a scalar epilogue (the lanes past size() hold garbage and must be masked or ignored, but are safe to read).
+
+  The containers read the alignment of their allocator through allocator_alignment<Alloc>:
+     + vector's data() is the start of the buffer, so it is always aligned
+     + devector places m_front on an aligned element whenever it (re)allocates, so data() is aligned after any
+       reserve or growth. push_front moves data() back by one element, so it is only aligned again at the next growth.
+
+  aligned_vector<T, Align> and aligned_devector<T, Align> are shorthands for the containers using this allocator.
+ */
+
+//We include memory for std::allocator
+#include <memory>
+//We include cstdlib for posix_memalign and free
+#include <cstdlib>
+//We include new for std::bad_alloc and placement new
+#include <new>
+//We include utility for std::forward
+#include <utility>
+//We include release_pages for can_release_pages
+#include "release_pages.hpp"
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace boost {
+  template <typename T, std::size_t Align = 64>
+  class aligned_allocator {
+  public:
+    //types:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind {
+      typedef aligned_allocator<U, Align> other;
+    };
+
+    //The actual alignment: never less than what T itself requires
+    static const std::size_t alignment = (Align > alignof(T) ? Align : alignof(T));
+    static_assert((Align & (Align - 1)) == 0, "aligned_allocator: Align must be a power of two");
+
+    aligned_allocator() noexcept {}
+
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+    /*
+      Returns NULL for n == 0, as there is nothing to align
+     */
+    T* allocate(size_type n) {
+      if (n == 0)
+        return NULL;
+      if (n > ((size_type)-1 - alignment) / sizeof(T))
+        throw std::bad_alloc();
+      size_type bytes = (n * sizeof(T) + alignment - 1) & ~(alignment - 1);
+      void * p = NULL;
+#if defined(_WIN32)
+      p = _aligned_malloc(bytes, alignment);
+#else
+      if (posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, bytes) != 0)
+        p = NULL;
+#endif
+      if (p == NULL)
+        throw std::bad_alloc();
+      return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_type) noexcept {
+#if defined(_WIN32)
+      _aligned_free(p);
+#else
+      free(p);
+#endif
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+      ::new ((void*)p) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    void destroy(U* p) {
+      p->~U();
+    }
+  };
+
+  template <typename T, std::size_t Align>
+  const std::size_t aligned_allocator<T, Align>::alignment;
+
+  template <typename T, typename U, std::size_t Align>
+  bool operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) noexcept {
+    return true;
+  }
+
+  template <typename T, typename U, std::size_t Align>
+  bool operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) noexcept {
+    return false;
+  }
+
+  /*
+    Alignment (in bytes) of the buffers returned by an allocator
+   */
+  template <class Alloc>
+  struct allocator_alignment {
+    static const std::size_t value = alignof(typename Alloc::value_type);
+  };
+
+  template <typename T, std::size_t Align>
+  struct allocator_alignment<aligned_allocator<T, Align> > {
+    static const std::size_t value = aligned_allocator<T, Align>::alignment;
+  };
+
+  //posix_memalign memory is malloc memory, so unused pages can be released too
+  template <typename T, std::size_t Align>
+  struct can_release_pages<aligned_allocator<T, Align> > : std::true_type {};
+};
+
+
+#endif
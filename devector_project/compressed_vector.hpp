@@ -0,0 +1,424 @@
+#ifndef BOOST_CONTAINER_CONTAINER_COMPRESSED_VECTOR_HPP
+#define BOOST_CONTAINER_CONTAINER_COMPRESSED_VECTOR_HPP
+
+/*
+  C++ compressed sequence of integers, built on top of boost::devector
+
+  Sorted or low-entropy integer sequences (ids, timestamps, offsets) stored in a devector<Int> take 4 or 8 bytes per
+  element, although consecutive values usually differ in their few low bits only. compressed_vector stores them in
+  blocks of 128 values, each block being its first value (the base) and the 128 deltas between consecutive values,
+  bit-packed with as many bits as the biggest delta of the block needs. Blocks with a negative delta store the deltas
+  zigzag coded (0, -1, 1, -2, ... as 0, 1, 2, 3, ...) so that small steps in both directions stay small; sorted blocks
+  store them as they are. A block of sorted values whose gaps fit in b bits takes 16 * b bytes, plus its header
+  (16 bytes for 32 bit Int, 24 bytes for 64 bit Int).
+
+  The deltas of a block are packed in a 4-lane vertical layout: value i goes to lane i % 4, and each lane is a
+  packed bit stream of its 32 values, with the words of the 4 lanes interleaved. So one 128 bit load gets the same
+  word of the 4 lanes, and a couple of SIMD shifts and a mask unpack 4 consecutive deltas at once, for any bit width.
+  The same registers are then zigzag decoded and prefix summed (two shifted adds, plus the running total of the
+  previous 4) back into values (SSE2, or a portable loop when SSE2 isn't available or BOOST_COMPRESSED_VECTOR_NO_SIMD
+  is defined).
+  The sums are taken modulo 2^32, so 64 bit blocks whose values don't all lie within 2^31 of the base store the raw
+  64 bit offsets from the base instead.
+
+     + push_back and push_front stage the values in small devectors at each end, and pack them as a new block at
+       that end every 128 values, so both are O(1) amortized
+     + operator[] and at() decode the one block holding the value, and keep it decoded, so accesses that stay in
+       the same block (as sequential ones do) only decode it once
+     + for_each and copy_to decode whole blocks with the SIMD kernel, for scans
+     + the packed words and the block headers live in devectors, appended and prepended with
+       append_uninitialized / prepend_uninitialized
+  Values can't be modified or erased (other than by clear), as that could change the width of a block.
+ */
+
+#include "devector.hpp"
+//We include vector for boost::exceptions
+#include "../vector.hpp"
+//We include cstdint for uint32_t and uint64_t
+#include <cstdint>
+//We include type_traits for make_unsigned
+#include <type_traits>
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(BOOST_COMPRESSED_VECTOR_NO_SIMD)
+#define BOOST_COMPRESSED_VECTOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace boost {
+  namespace detail {
+    static const unsigned packed_block_size = 128;
+    static const unsigned packed_lanes = 4;
+    static const unsigned packed_rows = packed_block_size / packed_lanes;
+
+    inline uint32_t zigzag_encode(uint32_t d) {
+      return (d << 1) ^ (uint32_t)((int32_t)d >> 31);
+    }
+
+    /*
+      Packs the 128 deltas with the given width (1 to 32) in the 4-lane vertical layout. words has 4 * bits elements
+     */
+    inline void pack_block(const uint32_t* deltas, unsigned bits, uint32_t* words) {
+      for (unsigned i=0; i<packed_lanes * bits; i++) {
+        words[i] = 0;
+      }
+      for (unsigned r=0; r<packed_rows; r++) {
+        unsigned bit = r * bits;
+        unsigned w = bit >> 5;
+        unsigned s = bit & 31;
+        for (unsigned l=0; l<packed_lanes; l++) {
+          uint32_t x = deltas[r * packed_lanes + l];
+          words[packed_lanes * w + l] |= x << s;
+          if (s + bits > 32)
+            words[packed_lanes * (w + 1) + l] |= x >> (32 - s);
+        }
+      }
+    }
+
+    /*
+      Unpacks the 128 deltas packed by pack_block (zigzag decoding them if zigzag is set), and writes their prefix
+      sums modulo 2^32 to offsets: offsets[i] = deltas[0] + ... + deltas[i]
+     */
+    inline void unpack_block(const uint32_t* words, unsigned bits, bool zigzag, uint32_t* offsets) {
+      uint32_t mask = (bits == 32 ? 0xFFFFFFFFu : (1u << bits) - 1);
+#ifdef BOOST_COMPRESSED_VECTOR_SSE2
+      __m128i vmask = _mm_set1_epi32((int)mask);
+      __m128i zz = _mm_cvtsi32_si128(zigzag ? 1 : 0); //shift count of the zigzag decode (0 leaves the deltas as they are)
+      __m128i zzbit = _mm_set1_epi32(zigzag ? 1 : 0);
+      __m128i total = _mm_setzero_si128(); //running sum, in all 4 lanes
+      for (unsigned r=0; r<packed_rows; r++) {
+        unsigned bit = r * bits;
+        unsigned w = bit >> 5;
+        unsigned s = bit & 31;
+        __m128i v = _mm_srl_epi32(_mm_loadu_si128((const __m128i*)(words + packed_lanes * w)), _mm_cvtsi32_si128((int)s));
+        if (s + bits > 32) {
+          __m128i next = _mm_loadu_si128((const __m128i*)(words + packed_lanes * (w + 1)));
+          v = _mm_or_si128(v, _mm_sll_epi32(next, _mm_cvtsi32_si128((int)(32 - s))));
+        }
+        v = _mm_and_si128(v, vmask);
+        v = _mm_xor_si128(_mm_srl_epi32(v, zz), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, zzbit)));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, total);
+        total = _mm_shuffle_epi32(v, 0xFF);
+        _mm_storeu_si128((__m128i*)(offsets + r * packed_lanes), v);
+      }
+#else
+      uint32_t total = 0;
+      for (unsigned r=0; r<packed_rows; r++) {
+        unsigned bit = r * bits;
+        unsigned w = bit >> 5;
+        unsigned s = bit & 31;
+        for (unsigned l=0; l<packed_lanes; l++) {
+          uint32_t x = words[packed_lanes * w + l] >> s;
+          if (s + bits > 32)
+            x |= words[packed_lanes * (w + 1) + l] << (32 - s);
+          x &= mask;
+          if (zigzag)
+            x = (x >> 1) ^ (0u - (x & 1));
+          total += x;
+          offsets[r * packed_lanes + l] = total;
+        }
+      }
+#endif
+    }
+  }
+
+  template <typename Int, class Alloc = std::allocator<Int> >
+  class compressed_vector {
+    static_assert(std::is_integral<Int>::value && sizeof(Int) <= 8, "compressed_vector needs an integer value_type");
+  public:
+    //types:
+    typedef Int value_type;
+    typedef typename std::make_unsigned<Int>::type unsigned_type;
+    typedef unsigned int size_type;
+
+    static const size_type block_size = detail::packed_block_size;
+
+  private:
+    struct block {
+      Int base; //first value of the block
+      unsigned char bits; //width of the packed deltas (0 to 32), or 64 for raw 64 bit offsets from the base
+      bool zigzag; //whether the deltas are zigzag coded
+      long long first_word; //index of the block's first word, counted from m_word_origin
+    };
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t> word_allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<block> block_allocator_type;
+
+  public:
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    compressed_vector() : m_word_origin(0), m_decoded_block(NO_BLOCK) {}
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_head.size() + m_blocks.size() * block_size + m_tail.size();
+    }
+
+    bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    /*
+      Number of packed blocks (the up to 2 * 127 staged values aren't in any)
+     */
+    size_type block_count() const noexcept {
+      return m_blocks.size();
+    }
+
+    /*
+      Bytes used by the live data (the values, packed or staged, and the block headers), not counting free capacity
+      nor the one decoded block kept for operator[]
+     */
+    std::size_t memory_bytes() const noexcept {
+      return m_words.size() * sizeof(uint32_t) + m_blocks.size() * sizeof(block) + (m_head.size() + m_tail.size()) * sizeof(Int);
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    /*
+      No bounds checking, as for devector. Decodes the block of the value, unless it's the one decoded last
+     */
+    Int operator[](size_type n) {
+      if (n < m_head.size())
+        return m_head[n];
+      n -= m_head.size();
+      size_type b = n / block_size;
+      if (b >= m_blocks.size())
+        return m_tail[n - m_blocks.size() * block_size];
+      block& blk = m_blocks[b];
+      if (blk.bits > 32)
+        return priv_raw(blk, n % block_size);
+      if (b != m_decoded_block) {
+        priv_unpack(blk, m_decoded);
+        m_decoded_block = b;
+      }
+      return priv_value(blk, m_decoded[n % block_size]);
+    }
+
+    Int at(size_type n) {
+      if (n >= size())
+        throw exceptions::out_of_bounds();
+      return (*this)[n];
+    }
+
+    /*
+      Calls f(value) for every value, in order, decoding one whole block at a time
+     */
+    template <class F>
+    void for_each(F f) {
+      for (size_type i=0; i<m_head.size(); i++) {
+        f(m_head[i]);
+      }
+      uint32_t offsets[block_size];
+      for (size_type b=0; b<m_blocks.size(); b++) {
+        block& blk = m_blocks[b];
+        if (blk.bits > 32) {
+          for (size_type i=0; i<block_size; i++) {
+            f(priv_raw(blk, i));
+          }
+          continue;
+        }
+        priv_unpack(blk, offsets);
+        for (size_type i=0; i<block_size; i++) {
+          f(priv_value(blk, offsets[i]));
+        }
+      }
+      for (size_type i=0; i<m_tail.size(); i++) {
+        f(m_tail[i]);
+      }
+    }
+
+    /*
+      Decodes every value to out, which must have room for size() values
+     */
+    void copy_to(Int* out) {
+      for (size_type i=0; i<m_head.size(); i++) {
+        *out++ = m_head[i];
+      }
+      uint32_t offsets[block_size];
+      for (size_type b=0; b<m_blocks.size(); b++) {
+        block& blk = m_blocks[b];
+        if (blk.bits > 32) {
+          for (size_type i=0; i<block_size; i++) {
+            *out++ = priv_raw(blk, i);
+          }
+          continue;
+        }
+        priv_unpack(blk, offsets);
+        for (size_type i=0; i<block_size; i++) {
+          out[i] = priv_value(blk, offsets[i]);
+        }
+        out += block_size;
+      }
+      for (size_type i=0; i<m_tail.size(); i++) {
+        *out++ = m_tail[i];
+      }
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    void push_back(Int x) {
+      m_tail.push_back(x);
+      if (m_tail.size() == block_size) {
+        priv_pack_back(m_tail.data());
+        m_tail.clear();
+      }
+    }
+
+    void push_front(Int x) {
+      m_head.push_front(x);
+      if (m_head.size() == block_size) {
+        priv_pack_front(m_head.data());
+        m_head.clear();
+      }
+    }
+
+    void clear() {
+      m_head.clear();
+      m_tail.clear();
+      m_blocks.clear();
+      m_words.clear();
+      m_word_origin = 0;
+      m_decoded_block = NO_BLOCK;
+    }
+
+  private:
+    static const size_type NO_BLOCK = (size_type)-1;
+
+    devector<Int, Alloc> m_head; //values pushed at the front and not packed yet
+    devector<block, block_allocator_type> m_blocks; //block headers, in order
+    devector<uint32_t, word_allocator_type> m_words; //packed deltas of every block, in order
+    devector<Int, Alloc> m_tail; //values pushed at the back and not packed yet
+    long long m_word_origin; //block::first_word of m_words[0] (decreases as blocks are prepended)
+    size_type m_decoded_block; //index of the block decoded in m_decoded, or NO_BLOCK
+    uint32_t m_decoded[block_size]; //offsets from the base of the values of that block
+
+    const uint32_t* priv_words(const block& blk) {
+      return m_words.data() + (blk.first_word - m_word_origin);
+    }
+
+    /*
+      The value at the given offset (modulo 2^32) from the base of a block of at most 32 bits
+     */
+    static Int priv_value(const block& blk, uint32_t offset) {
+      return (Int)((unsigned_type)blk.base + (unsigned_type)(int32_t)offset);
+    }
+
+    Int priv_raw(const block& blk, size_type i) {
+      const uint32_t* words = priv_words(blk);
+      uint64_t offset = (uint64_t)words[2 * i] | ((uint64_t)words[2 * i + 1] << 32);
+      return (Int)((unsigned_type)blk.base + (unsigned_type)offset);
+    }
+
+    void priv_unpack(const block& blk, uint32_t* offsets) {
+      if (blk.bits == 0) {
+        for (size_type i=0; i<block_size; i++) {
+          offsets[i] = 0;
+        }
+      } else {
+        detail::unpack_block(priv_words(blk), blk.bits, blk.zigzag, offsets);
+      }
+    }
+
+    static unsigned priv_width(uint32_t x) {
+#if defined(__GNUC__)
+      return (x == 0 ? 0 : 32 - __builtin_clz(x));
+#else
+      unsigned width = 0;
+      while (x != 0) {
+        x >>= 1;
+        width++;
+      }
+      return width;
+#endif
+    }
+
+    /*
+      Computes the deltas of the 128 values, the header of their block and the number of words it needs
+     */
+    static block priv_header(const Int* values, uint32_t* deltas, size_type& words) {
+      block blk;
+      blk.base = values[0];
+      bool fits = true; //whether every value is within 2^31 of the base (always true up to 32 bit Int, modulo 2^32)
+      uint32_t previous = 0, plain = 0, zigzag = 0;
+      for (size_type i=0; i<block_size; i++) {
+        uint64_t offset = (uint64_t)((unsigned_type)values[i] - (unsigned_type)blk.base);
+        if (sizeof(Int) > 4 && (int64_t)offset != (int32_t)offset)
+          fits = false;
+        deltas[i] = (uint32_t)offset - previous;
+        previous = (uint32_t)offset;
+        plain |= deltas[i];
+        zigzag |= detail::zigzag_encode(deltas[i]);
+      }
+      blk.zigzag = (priv_width(zigzag) < priv_width(plain));
+      blk.bits = (unsigned char)priv_width(blk.zigzag ? zigzag : plain);
+      if (!fits)
+        blk.bits = 64;
+      words = (blk.bits > 32 ? 2 * block_size : detail::packed_lanes * blk.bits);
+      return blk;
+    }
+
+    static void priv_encode(const block& blk, const Int* values, uint32_t* deltas, uint32_t* words) {
+      if (blk.bits == 0)
+        return;
+      if (blk.bits > 32) {
+        for (size_type i=0; i<block_size; i++) {
+          uint64_t x = (uint64_t)((unsigned_type)values[i] - (unsigned_type)blk.base);
+          words[2 * i] = (uint32_t)x;
+          words[2 * i + 1] = (uint32_t)(x >> 32);
+        }
+        return;
+      }
+      if (blk.zigzag) {
+        for (size_type i=0; i<block_size; i++) {
+          deltas[i] = detail::zigzag_encode(deltas[i]);
+        }
+      }
+      detail::pack_block(deltas, blk.bits, words);
+    }
+
+    void priv_pack_back(const Int* values) {
+      size_type words;
+      uint32_t deltas[block_size];
+      block blk = priv_header(values, deltas, words);
+      blk.first_word = m_word_origin + m_words.size();
+      priv_encode(blk, values, deltas, m_words.append_uninitialized(words).data());
+      m_blocks.push_back(blk); //the words are only committed once the header is in
+      m_words.commit(words);
+    }
+
+    void priv_pack_front(const Int* values) {
+      size_type words;
+      uint32_t deltas[block_size];
+      block blk = priv_header(values, deltas, words);
+      blk.first_word = m_word_origin - words;
+      priv_encode(blk, values, deltas, m_words.prepend_uninitialized(words).data());
+      m_blocks.push_front(blk); //the words are only committed once the header is in
+      m_words.commit_front(words);
+      m_word_origin -= words;
+      if (m_decoded_block != NO_BLOCK)
+        m_decoded_block++; //the blocks after it moved up by one
+    }
+  };
+
+  template <typename Int, class Alloc>
+  const typename compressed_vector<Int, Alloc>::size_type compressed_vector<Int, Alloc>::block_size;
+
+  template <typename Int, class Alloc>
+  const typename compressed_vector<Int, Alloc>::size_type compressed_vector<Int, Alloc>::NO_BLOCK;
+};
+
+
+#endif
@@ -39,10 +39,24 @@
 
 //Memory is used to include std::allocator, in theory, we can use any allocator who gives us contiguous memory blocks of the size we request
 #include <memory>
-//We include cstring for memcpy
-#include <cstring>
 //We include limits for max_size
 #include <limits>
+//We include utility for std::swap
+#include <utility>
+//We include algorithm for std::move and std::move_backward (erase of types that can't be relocated safely)
+#include <algorithm>
+//We include iterator for std::distance
+#include <iterator>
+//We include release_pages for the madvise based automatic shrink
+#include "../release_pages.hpp"
+//We include aligned_allocator for allocator_alignment (and the aligned_devector shorthand)
+#include "../aligned_allocator.hpp"
+//We include relocate to move the elements to a new buffer (memcpy, move or copy, depending on T), and for default_init
+#include "../relocate.hpp"
+//We include span for append_uninitialized and prepend_uninitialized
+#include "../span.hpp"
+//We include vector for boost::exceptions
+#include "../vector.hpp"
 
 /*
   These are the constants for the amortized time push_back.
@@ -55,9 +69,41 @@
     (INC,MULT) = (1,0) would give us the time O(n^2) but with list-like memory eficiency
   and:
     (INC,MULT) = (1,1.6f) would give us a vector like the Dinkumware implementation (Visual Studio)
+  Both can be set from the command line (e.g. -DVECTOR_AMORT_INC=1 -DVECTOR_AMORT_MULT=1.5f), as the benchmarks do.
  */
+#ifndef VECTOR_AMORT_INC
 #define VECTOR_AMORT_INC 0
+#endif
+#ifndef VECTOR_AMORT_MULT
 #define VECTOR_AMORT_MULT 2
+#endif
+
+/*
+  These are the constants for the automatic shrink, shared with vector.hpp.
+  whenever a pop leaves the devector with less than (capacity / SHRINK_DIV) elements, its capacity is reduced to
+  (size * SHRINK_MULT) elements. With SHRINK_DIV > SHRINK_MULT this has hysteresis, so alternating pushes and pops
+  around the threshold don't thrash.
+
+  Buffers smaller than SHRINK_MIN_BYTES are never shrunk automatically, nor below that size.
+  Buffers of at least SHRINK_MADVISE_BYTES are not reallocated: the pages at both ends, outside the
+  (size * SHRINK_MULT) elements around the live ones, are handed back to the OS instead (see release_pages.hpp).
+
+  The shrink never goes below the capacity left by the last reserve, reserve_front or reserve_back.
+
+  As for vector, the automatic shrink is opt in: SHRINK_DIV = 0 (the default) disables it.
+ */
+#ifndef VECTOR_SHRINK_DIV
+#define VECTOR_SHRINK_DIV 0
+#endif
+#ifndef VECTOR_SHRINK_MULT
+#define VECTOR_SHRINK_MULT 2
+#endif
+#ifndef VECTOR_SHRINK_MIN_BYTES
+#define VECTOR_SHRINK_MIN_BYTES 4096
+#endif
+#ifndef VECTOR_SHRINK_MADVISE_BYTES
+#define VECTOR_SHRINK_MADVISE_BYTES (1 << 20)
+#endif
 
 namespace boost {
   /*
@@ -89,6 +135,8 @@ namespace boost {
         m_capacity = 1;
         m_front = 0;
         m_size = 0;
+        m_trimmed = 0;
+        m_reserved = 0;
         m_buffer = m_allocator.allocate(m_capacity);
       }  catch (const std::exception& e) {
         m_capacity = 0;
@@ -144,36 +192,26 @@ namespace boost {
     }
 
     /*
-      This function is ugly and should be remade
+      Resizes the container to n elements, destroying the last ones or appending value initialized ones.
+      Strong guarantee (if a constructor throws, the appended elements are destroyed again)
      */
     void resize(size_type n) {
       size_type i;
-      size_type new_front;
-      value_type * pre_buffer;
-      if (n<1) n=1; //we do not throw here, because it makes much more sense to just resize to the minimum size (1);
-      if (n < m_capacity) {
-        //then we have strong guarantee
-        if (n>m_size) 
-          new_front = (n - m_size)/2;
-        else
-          new_front = 0;
-        pre_buffer = m_allocator.allocate(n); 
-        memcpy(pre_buffer + new_front, m_buffer + m_first, ((byte*)(m_buffer + m_first + n)) - ((byte*)(m_buffer+m_first)));
-        m_allocator.deallocate(m_buffer, m_capacity);
-        m_buffer = pre_buffer;
-        m_capacity = n;
-        m_fromt = new_front;
-        m_size = (m_size < n ? m_size : n);
-      } else if (n > m_capacity-m_front) {
-        reserve(1.5*n);
-        //from here on it's weak guarantee
+      if (n < m_size) {
+        for (i=n; i<m_size; i++) {
+          m_allocator.destroy(m_buffer + m_front + i);
+        }
+        m_size = n;
+        priv_auto_shrink();
+      } else if (n > m_size) {
+        priv_reserve_back(priv_grown_room(n - m_size));
         try {
           for (i=m_size; i<n; i++) {
-            m_allocator.construct(m_buffer + m_front + i); 
+            m_allocator.construct(m_buffer + m_front + i);
           }
         } catch (const std::exception& e) {
           for (size_type j=m_size; j<i; j++) {
-            m_allocator.destroy(m_buffer + m_front + j); //To mantain weak guarantee
+            m_allocator.destroy(m_buffer + m_front + j);
           }
           throw e;
         }
@@ -181,6 +219,20 @@ namespace boost {
       }
     }
 
+    /*
+      Like resize, but the new elements are default initialized instead of value initialized: trivial types are left
+      uninitialized, so growing a byte buffer doesn't zero it first. Strong guarantee
+     */
+    void resize_default_init(size_type n) {
+      if (n < m_size) {
+        resize(n);
+      } else if (n > m_size) {
+        priv_reserve_back(priv_grown_room(n - m_size));
+        default_init(m_buffer + m_front + m_size, m_buffer + m_front + n);
+        m_size = n;
+      }
+    }
+
     size_type capacity() const noexcept {
       return m_capacity;
     }
@@ -189,15 +241,47 @@ namespace boost {
       return (m_size == 0);
     }
 
+    /*
+      Reallocates to exactly max(size(), 1) elements. Strong guarantee
+     */
     void shrink_to_fit() {
-      resize(m_size >= 1 ? m_size : 1);
+      if (m_capacity > m_size && m_capacity > 1)
+        priv_shrink(m_size >= 1 ? m_size : 1);
+      m_reserved = 0; //the caller gave the reserved room back
     }
 
     /*
-      Strong guarantee met
+      Strong guarantee met. The automatic shrink keeps the room reserved here (and by reserve_front, reserve_back)
     */
     void reserve(size_type n) {
       priv_reserve_mid(n);
+      m_reserved = m_capacity;
+    }
+
+    /*
+      Makes sure there is room for at least n more elements before the first one (or after the last one), so that
+      the next n push_front (push_back) calls don't reallocate. Only the free space at that end grows, to exactly
+      n if it reallocates. Strong guarantee
+     */
+    void reserve_front(size_type n) {
+      priv_reserve_front(n);
+      m_reserved = m_capacity;
+    }
+
+    void reserve_back(size_type n) {
+      priv_reserve_back(n);
+      m_reserved = m_capacity;
+    }
+
+    /*
+      Number of elements that fit before the first element (after the last one) without reallocating
+     */
+    size_type front_free_capacity() const noexcept {
+      return m_front;
+    }
+
+    size_type back_free_capacity() const noexcept {
+      return m_capacity - m_front - m_size;
     }
 
   /*
@@ -235,24 +319,211 @@ namespace boost {
   */
     void push_back(const T& x) {
       if(m_capacity <= m_size + m_front) {
-        reserve((m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
+        priv_reserve_mid((m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
       }
       m_allocator.construct(m_buffer + m_front + m_size);
       m_buffer[m_front + m_size] = x;
       m_size++;
     }
 
+    void push_back(T&& x) {
+      if(m_capacity <= m_size + m_front) {
+        priv_reserve_mid((m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
+      }
+      m_allocator.construct(m_buffer + m_front + m_size, std::move(x));
+      m_size++;
+    }
+
     void push_front(const T& x) {
       if(m_front == 0) {
-        reserve((m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
+        priv_reserve_mid((m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
       }
       m_allocator.construct(m_buffer + m_front - 1);
       m_buffer[m_front-1] = x;
       m_size++; m_front--;
     }
 
-    void clear() {
-      resize(0);
+    void push_front(T&& x) {
+      if(m_front == 0) {
+        priv_reserve_mid((m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
+      }
+      m_allocator.construct(m_buffer + m_front - 1, std::move(x));
+      m_size++; m_front--;
+    }
+
+    /*
+      Returns the n elements past the end as a writable span of raw memory, growing the back (geometrically) if they
+      don't fit. size() doesn't change until commit(k) adopts the first k of them, e.g.
+        ssize_t k = recv(fd, d.append_uninitialized(4096).data(), 4096, 0);
+        d.commit(k > 0 ? k : 0);
+      Only for trivial types, whose objects need no construction. A span that wasn't committed yet is invalidated by
+      any reallocation.
+     */
+    span<T> append_uninitialized(size_type n) {
+      static_assert(std::is_trivial<T>::value, "append_uninitialized needs a trivial value_type");
+      if (m_capacity - m_front - m_size < n)
+        priv_reserve_back(priv_grown_room(n));
+      return span<T>(m_buffer + m_front + m_size, n);
+    }
+
+    /*
+      Adopts the first k elements past the end (written through append_uninitialized) as elements.
+      Throws buffer_overflow if there are less than k free elements after the last one, as vector::commit does
+     */
+    void commit(size_type k) {
+      static_assert(std::is_trivial<T>::value, "commit needs a trivial value_type");
+      if (k > back_free_capacity())
+        throw exceptions::buffer_overflow();
+      m_size += k;
+    }
+
+    /*
+      Front counterpart of append_uninitialized: returns the n elements before the first one as a writable span.
+      commit_front(k) adopts the LAST k of them (the ones next to the current front), so e.g. a header of k bytes
+      is written at span.data() + span.size() - k
+     */
+    span<T> prepend_uninitialized(size_type n) {
+      static_assert(std::is_trivial<T>::value, "prepend_uninitialized needs a trivial value_type");
+      if (m_front < n)
+        priv_reserve_front(priv_grown_room(n));
+      return span<T>(m_buffer + m_front - n, n);
+    }
+
+    /*
+      Adopts the k elements before the first one (written through prepend_uninitialized) as elements.
+      Throws buffer_overflow if there are less than k free elements before the first one
+     */
+    void commit_front(size_type k) {
+      static_assert(std::is_trivial<T>::value, "commit_front needs a trivial value_type");
+      if (k > m_front)
+        throw exceptions::buffer_overflow();
+      m_front -= k;
+      m_size += k;
+    }
+
+    void pop_back() {
+      m_allocator.destroy(m_buffer + m_front + --m_size);
+      priv_auto_shrink();
+    }
+
+    void pop_front() {
+      m_allocator.destroy(m_buffer + m_front);
+      m_front++; m_size--;
+      priv_auto_shrink();
+    }
+
+    /*
+      Destroys the first (last) n elements, which must exist. Unlike pop_front (pop_back) and erase, the automatic
+      shrink is not applied: the buffer stays where it is, so the free room at both ends and pointers to the other
+      elements remain valid. O(1) for trivial types
+     */
+    void erase_front(size_type n) noexcept {
+      for (size_type i=0; i<n; i++) {
+        m_allocator.destroy(m_buffer + m_front + i);
+      }
+      m_front += n; m_size -= n;
+    }
+
+    void erase_back(size_type n) noexcept {
+      for (size_type i=m_size - n; i<m_size; i++) {
+        m_allocator.destroy(m_buffer + m_front + i);
+      }
+      m_size -= n;
+    }
+
+    /*
+      Inserts x before pos, moving the elements on the shorter side of pos to make room, so it costs
+      O(min(i, size() - i)) (O(1) next to either end) plus the amortized growth if that side is full.
+      Returns an iterator to the new element. Strong guarantee
+     */
+    iterator insert(iterator pos, const T& x) {
+      value_type tmp(x); //x may be an element of this devector, which is about to move
+      return insert(pos, std::move(tmp));
+    }
+
+    iterator insert(iterator pos, T&& x) {
+      return priv_insert(pos - begin(), 1, [&](T* gap) {
+        m_allocator.construct(gap, std::move(x));
+      });
+    }
+
+    /*
+      Inserts a copy of [first, last) before pos, as insert(pos, x) does. The range must not be part of this devector.
+      Strong guarantee
+     */
+    template <class ForwardIt>
+    iterator insert(iterator pos, ForwardIt first, ForwardIt last) {
+      size_type k = std::distance(first, last);
+      return priv_insert(pos - begin(), k, [&](T* gap) {
+        T* cur = gap;
+        try {
+          for (; first!=last; ++first, ++cur) {
+            m_allocator.construct(cur, *first);
+          }
+        } catch (...) {
+          for (T* p=gap; p!=cur; ++p) {
+            m_allocator.destroy(p);
+          }
+          throw;
+        }
+      });
+    }
+
+    /*
+      Erases the element at pos, closing the hole from the shorter side. Returns an iterator to the element that
+      followed it
+     */
+    iterator erase(iterator pos) {
+      return erase(pos, pos + 1);
+    }
+
+    /*
+      Erases [first, last), closing the hole from the shorter side. Returns an iterator to the element that followed
+      them. Never throws for nothrow relocatable types, basic guarantee (as std::vector) otherwise
+     */
+    iterator erase(iterator first, iterator last) {
+      size_type i = first - begin();
+      size_type k = last - first;
+      if (k == 0)
+        return first;
+      priv_erase(i, k, typename is_nothrow_relocatable<T>::type());
+      priv_auto_shrink();
+      return begin() + i;
+    }
+
+    void swap(devector& other) noexcept {
+      std::swap(m_front, other.m_front);
+      std::swap(m_size, other.m_size);
+      std::swap(m_capacity, other.m_capacity);
+      std::swap(m_allocator, other.m_allocator);
+      std::swap(m_buffer, other.m_buffer);
+      std::swap(m_trimmed, other.m_trimmed);
+      std::swap(m_reserved, other.m_reserved);
+    }
+
+    /*
+      Destroys every element but keeps the buffer (see vector::clear)
+     */
+    void clear() noexcept {
+      for (size_type i=0; i<m_size; i++) {
+        m_allocator.destroy(m_buffer + m_front + i);
+      }
+      m_size = 0;
+      m_front = priv_align_front(m_capacity / 2); //leave the same room at both ends
+      m_trimmed = 0;
+    }
+
+    /*
+      Like clear, but leaves front_room elements (at most the capacity) free at the front instead of centring,
+      for a caller that knows how much room each end needs
+     */
+    void clear(size_type front_room) noexcept {
+      for (size_type i=0; i<m_size; i++) {
+        m_allocator.destroy(m_buffer + m_front + i);
+      }
+      m_size = 0;
+      m_front = (front_room < m_capacity ? front_room : m_capacity);
+      m_trimmed = 0;
     }
     
 
@@ -263,16 +534,253 @@ namespace boost {
     size_type m_capacity; //number of allocated elements, it's always >=1
     Alloc m_allocator; //allocator class
     T* m_buffer; //array of elements
+    size_type m_trimmed; //pages outside the m_trimmed elements around the live ones were released to the OS (0 if none were)
+    size_type m_reserved; //capacity left by the last reserve, reserve_front or reserve_back, which the automatic shrink keeps
+
+
+    static constexpr std::size_t priv_gcd(std::size_t a, std::size_t b) {
+      return b == 0 ? a : priv_gcd(b, a % b);
+    }
 
+    /*
+      Rounds front down to the closest element whose address is aligned as the allocator's buffers are
+      (e.g. a multiple of 16 elements for 4 byte elements in 64 byte aligned buffers), unless that would leave
+      no room at all at the front
+     */
+    static size_type priv_align_front(size_type front) noexcept {
+      const std::size_t step = allocator_alignment<Alloc>::value / priv_gcd(allocator_alignment<Alloc>::value, sizeof(T));
+      return (front < step ? front : front - front % step);
+    }
+
+    /*
+      Relocates the elements to pre_buffer (of n elements) starting at new_front. If that throws, pre_buffer is
+      deallocated and the devector is left untouched
+     */
+    void priv_relocate_to(value_type * pre_buffer, size_type n, size_type new_front) {
+      try {
+        relocate(m_allocator, m_buffer + m_front, m_buffer + m_front + m_size, pre_buffer + new_front);
+      } catch (...) {
+        m_allocator.deallocate(pre_buffer, n);
+        throw;
+      }
+    }
+
+    /*
+      Free room to reserve at one end so that at least n elements fit, growing geometrically like push_back does
+     */
+    size_type priv_grown_room(size_type n) const {
+      size_type grown = (m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT);
+      size_type room = (grown > m_capacity ? grown - m_capacity : 0);
+      return (n > room ? n : room);
+    }
+
+    /*
+      Makes room for k elements at index i, fills it with construct(gap) (which must clean up after itself if it
+      throws) and returns an iterator to them
+     */
+    template <class Construct>
+    iterator priv_insert(size_type i, size_type k, Construct construct) {
+      if (k == 0)
+        return begin() + i;
+      priv_insert(i, k, construct, typename is_nothrow_relocatable<T>::type());
+      return begin() + i;
+    }
+
+    /*
+      Elements that relocate without throwing are shifted in place (memmove for the trivially relocatable ones), or
+      relocated to a bigger buffer around the gap if the shorter side has no room. If construct throws, the gap is
+      closed again
+     */
+    template <class Construct>
+    void priv_insert(size_type i, size_type k, Construct& construct, std::true_type) {
+      bool front_side = (i < m_size - i);
+      if (front_side ? m_front < k : m_capacity - m_front - m_size < k) {
+        size_type grown = (m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT);
+        size_type n = (grown > m_size + k ? grown : m_size + k);
+        value_type * pre_buffer = m_allocator.allocate(n); //Throws if allocate throws, nothing changed yet
+        size_type new_front = priv_align_front((n - m_size - k)/2);
+        relocate(m_allocator, begin(), begin() + i, pre_buffer + new_front);
+        relocate(m_allocator, begin() + i, end(), pre_buffer + new_front + i + k);
+        m_allocator.deallocate(m_buffer, m_capacity);
+        m_buffer = pre_buffer;
+        m_front = new_front;
+        m_capacity = n;
+        m_trimmed = 0;
+      } else if (front_side) {
+        relocate_overlapping(m_allocator, begin(), begin() + i, begin() - k);
+        m_front -= k;
+      } else {
+        relocate_overlapping(m_allocator, begin() + i, end(), begin() + i + k);
+      }
+      m_size += k;
+      try {
+        construct(begin() + i);
+      } catch (...) {
+        priv_close_gap(i, k);
+        throw;
+      }
+    }
+
+    /*
+      Elements whose relocation may throw can't be shifted in place without risking a hole in the middle, so they
+      are copied (or moved, if that can't throw) to a new buffer and the old one is only released once everything
+      succeeded
+     */
+    template <class Construct>
+    void priv_insert(size_type i, size_type k, Construct& construct, std::false_type) {
+      size_type grown = (m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT);
+      size_type n = (grown > m_size + k ? grown : m_size + k);
+      value_type * pre_buffer = m_allocator.allocate(n);
+      size_type new_front = priv_align_front((n - m_size - k)/2);
+      T* dest = pre_buffer + new_front;
+      size_type j = 0;
+      try {
+        for (; j<m_size; j++) {
+          m_allocator.construct(dest + (j < i ? j : j + k), std::move_if_noexcept(m_buffer[m_front + j]));
+        }
+        construct(dest + i);
+      } catch (...) {
+        for (size_type l=0; l<j; l++) {
+          m_allocator.destroy(dest + (l < i ? l : l + k));
+        }
+        m_allocator.deallocate(pre_buffer, n);
+        throw;
+      }
+      for (j=0; j<m_size; j++) {
+        m_allocator.destroy(m_buffer + m_front + j);
+      }
+      m_allocator.deallocate(m_buffer, m_capacity);
+      m_buffer = pre_buffer;
+      m_front = new_front;
+      m_capacity = n;
+      m_size += k;
+      m_trimmed = 0;
+    }
+
+    /*
+      Closes the hole of k raw elements at index i by shifting the shorter side over it
+     */
+    void priv_close_gap(size_type i, size_type k) noexcept {
+      if (i < m_size - i - k) {
+        relocate_overlapping(m_allocator, begin(), begin() + i, begin() + k);
+        m_front += k;
+      } else {
+        relocate_overlapping(m_allocator, begin() + i + k, end(), begin() + i);
+      }
+      m_size -= k;
+    }
+
+    void priv_erase(size_type i, size_type k, std::true_type) noexcept {
+      for (T* p=begin() + i; p!=begin() + i + k; ++p) {
+        m_allocator.destroy(p);
+      }
+      priv_close_gap(i, k);
+    }
+
+    /*
+      Elements whose relocation may throw are move assigned over the erased ones instead, as std::vector::erase does,
+      and the k elements left over at the shorter end are destroyed
+     */
+    void priv_erase(size_type i, size_type k, std::false_type) {
+      T* hole = begin() + i;
+      if (i < m_size - i - k) {
+        std::move_backward(begin(), hole, hole + k);
+        for (size_type j=0; j<k; j++) {
+          m_allocator.destroy(m_buffer + m_front);
+          m_front++; m_size--;
+        }
+      } else {
+        std::move(hole + k, end(), hole);
+        for (size_type j=0; j<k; j++) {
+          m_allocator.destroy(m_buffer + m_front + --m_size);
+        }
+      }
+    }
 
     /*
       Reserves space to have at least n free elements, if reallocation happens, m_first = m_first + increase_in_capacity.
      */
-    void priv_reserve_front(size_type n);
+    void priv_reserve_front(size_type n) {
+      value_type * pre_buffer;
+      if (m_front < n) {
+        size_type new_capacity = n + m_capacity - m_front;
+        pre_buffer = m_allocator.allocate(new_capacity);
+        priv_relocate_to(pre_buffer, new_capacity, n);
+        m_allocator.deallocate(m_buffer, m_capacity);
+        m_buffer = pre_buffer;
+        m_front = n;
+        m_capacity = new_capacity;
+        m_trimmed = 0;
+      }
+    }
     /*
       Reserves to have at least n free elements, if reallocation happens, first is left unchanged.
      */
-    void priv_reserve_back(size_type n);
+    void priv_reserve_back(size_type n) {
+      value_type * pre_buffer;
+      if (m_capacity - m_front - m_size < n) {
+        size_type new_capacity = m_front + m_size + n;
+        pre_buffer = m_allocator.allocate(new_capacity);
+        priv_relocate_to(pre_buffer, new_capacity, m_front);
+        m_allocator.deallocate(m_buffer, m_capacity);
+        m_buffer = pre_buffer;
+        m_capacity = new_capacity;
+        m_trimmed = 0;
+      }
+    }
+
+    /*
+      Reallocates to exactly n >= max(m_size, 1) elements, with the free space split evenly between both ends
+     */
+    void priv_shrink(size_type n) {
+      value_type * pre_buffer = m_allocator.allocate(n);
+      size_type new_front = priv_align_front((n - m_size)/2);
+      priv_relocate_to(pre_buffer, n, new_front);
+      m_allocator.deallocate(m_buffer, m_capacity);
+      m_buffer = pre_buffer;
+      m_front = new_front;
+      m_capacity = n;
+      m_trimmed = 0;
+    }
+
+    /*
+      Applies the automatic shrink policy after elements were removed. The free space kept is split evenly between
+      both ends, as priv_reserve_mid does. Never throws: if the smaller buffer can't be allocated we keep the bigger one.
+     */
+    void priv_auto_shrink() noexcept {
+#if VECTOR_SHRINK_DIV != 0
+      if ((std::size_t)m_capacity * sizeof(T) < VECTOR_SHRINK_MIN_BYTES)
+        return;
+      if (m_size + 1 > m_trimmed) //the released pages were written to again since the last shrink
+        m_trimmed = 0;
+      size_type watermark = (m_trimmed != 0 ? m_trimmed : m_capacity);
+      if (m_size >= watermark / VECTOR_SHRINK_DIV)
+        return;
+      size_type target = m_size * VECTOR_SHRINK_MULT;
+      if ((std::size_t)target * sizeof(T) < VECTOR_SHRINK_MIN_BYTES)
+        target = VECTOR_SHRINK_MIN_BYTES / sizeof(T);
+      if (target < 1)
+        target = 1;
+      if (target < m_reserved)
+        target = m_reserved;
+      if (target >= watermark)
+        return;
+      if (can_release_pages<Alloc>::value && (std::size_t)m_capacity * sizeof(T) >= VECTOR_SHRINK_MADVISE_BYTES) {
+        size_type room = (target - m_size) / 2;
+        size_type first = (m_front > room ? m_front - room : 0);
+        size_type last = m_front + m_size + room;
+        detail::release_pages(m_buffer, m_buffer + first);
+        if (last < m_capacity)
+          detail::release_pages(m_buffer + last, m_buffer + m_capacity);
+        m_trimmed = target;
+      } else {
+        try {
+          priv_shrink(target);
+        } catch (...) {
+        }
+      }
+#endif
+    }
 
     /*
       Reserves space for at least n elements and sets first so that the free size on the begining is at most 1 less than the free space at the end
@@ -287,15 +795,19 @@ namespace boost {
         } catch (const std::exception& e) {
           throw e;
         }        
-        new_front = (n - m_size)/2;        
-        memcpy(pre_buffer + new_front, m_buffer + m_front, ((byte*)(m_buffer + m_front + m_size)) - ((byte*)(m_buffer + m_front))) ;
+        new_front = priv_align_front((n - m_size)/2);
+        priv_relocate_to(pre_buffer, n, new_front);
         m_allocator.deallocate(m_buffer, m_capacity);
         m_buffer = pre_buffer;
         m_front = new_front;
         m_capacity = n;
+        m_trimmed = 0;
       }
     }
   };
+
+  template <typename T, std::size_t Align = 64>
+  using aligned_devector = devector<T, aligned_allocator<T, Align> >;
 };
 
 
@@ -0,0 +1,403 @@
+#ifndef BOOST_CONTAINER_CONTAINER_FLAT_MAP_HPP
+#define BOOST_CONTAINER_CONTAINER_FLAT_MAP_HPP
+
+
+/*
+  C++ flat_set and flat_map built on top of boost::devector
+
+  These are sorted associative containers that keep their elements in contiguous memory instead of in tree nodes.
+  They differ from the usual sorted-vector containers in the following:
+     + Storage is a devector, so an insert or erase shifts the elements towards whichever end of the container is closer.
+       This halves the expected cost of a random insert and makes front biased inserts (e.g. decreasing keys) O(1)
+     + flat_map keeps keys and values in two separate arrays, so a lookup only touches the cache lines holding keys
+     + Lookups on arithmetic and pointer keys compared with std::less/std::greater use a branchless binary search
+     + insert_sorted(first, last) merges an already sorted range in a single pass
+
+  Iterators were skipped, as flat_map has no contiguous value_type to point to.
+  Elements are reached by index instead (key_at, value_at), in ascending order.
+  As with devector, const functions were mostly skipped.
+ */
+
+#include "devector.hpp"
+//We include functional for std::less and std::greater
+#include <functional>
+//We include algorithm for std::lower_bound
+#include <algorithm>
+//We include type_traits to pick the lookup strategy at compile time
+#include <type_traits>
+
+namespace boost {
+  namespace detail {
+    /*
+      Keys that fit in a register and are compared with a builtin operator can be searched without branches:
+      the loop below always runs log2(n) times and compilers turn the select into a cmov.
+     */
+    template <typename K, class Compare>
+    struct is_branchless_searchable : std::integral_constant<bool,
+      (std::is_arithmetic<K>::value || std::is_pointer<K>::value) &&
+      (std::is_same<Compare, std::less<K> >::value || std::is_same<Compare, std::greater<K> >::value)> {};
+
+    template <typename K, class Compare, typename size_type>
+    K* flat_lower_bound(K* first, size_type n, const K& key, Compare& comp, std::true_type) {
+      if (n == 0) return first;
+      while (n > 1) {
+        size_type half = n / 2;
+        first = comp(first[half], key) ? first + half : first;
+        n -= half;
+      }
+      return first + comp(*first, key);
+    }
+
+    template <typename K, class Compare, typename size_type>
+    K* flat_lower_bound(K* first, size_type n, const K& key, Compare& comp, std::false_type) {
+      return std::lower_bound(first, first + n, key, comp);
+    }
+  }
+
+  template <typename K, class Compare = std::less<K>, class Alloc = std::allocator<K> >
+  class flat_set {
+  public:
+    //types:
+    typedef K key_type;
+    typedef K value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef devector<K, Alloc> storage_type;
+    typedef typename storage_type::iterator iterator;
+    typedef typename storage_type::size_type size_type;
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    flat_set() {}
+
+    explicit flat_set(const Compare& comp) : m_compare(comp) {}
+
+  /*
+  ========================================
+  Iterators
+  ========================================
+  */
+    iterator begin() noexcept {
+      return m_keys.begin();
+    }
+
+    iterator end() noexcept {
+      return m_keys.end();
+    }
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_keys.size();
+    }
+
+    bool empty() const noexcept {
+      return m_keys.empty();
+    }
+
+    size_type capacity() const noexcept {
+      return m_keys.capacity();
+    }
+
+    void reserve(size_type n) {
+      m_keys.reserve(n);
+    }
+
+  /*
+  ========================================
+  Lookup
+  ========================================
+  */
+    iterator lower_bound(const K& key) {
+      return detail::flat_lower_bound(m_keys.begin(), m_keys.size(), key, m_compare,
+                                      detail::is_branchless_searchable<K, Compare>());
+    }
+
+    iterator find(const K& key) {
+      iterator it = lower_bound(key);
+      if (it != end() && !m_compare(key, *it))
+        return it;
+      return end();
+    }
+
+    size_type count(const K& key) {
+      return find(key) != end();
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Returns the position of key and whether it was inserted
+      Strong guarantee
+     */
+    std::pair<iterator, bool> insert(const K& key) {
+      iterator it = lower_bound(key);
+      size_type i = it - begin();
+      if (it != end() && !m_compare(key, *it))
+        return std::make_pair(it, false);
+      m_keys.insert(m_keys.begin() + i, key);
+      return std::make_pair(begin() + i, true);
+    }
+
+    /*
+      Merges the sorted range [first, last) into the set in O(size() + distance(first, last)).
+      Keys already present, or repeated inside the range, are kept only once.
+      Strong guarantee (the merge is built on a new buffer)
+     */
+    template <class ForwardIt>
+    void insert_sorted(ForwardIt first, ForwardIt last) {
+      storage_type merged;
+      size_type i = 0, n = m_keys.size();
+      merged.reserve(n + std::distance(first, last));
+      while (i < n || first != last) {
+        const K* next;
+        if (first == last || (i < n && !m_compare(*first, m_keys[i]))) {
+          next = &m_keys[i];
+          if (first != last && !m_compare(m_keys[i], *first)) ++first; //same key on both sides
+          i++;
+        } else {
+          next = &*first;
+          ++first;
+        }
+        if (merged.empty() || m_compare(merged.back(), *next))
+          merged.push_back(*next);
+      }
+      m_keys.swap(merged);
+    }
+
+    size_type erase(const K& key) {
+      iterator it = find(key);
+      if (it == end())
+        return 0;
+      m_keys.erase(it);
+      return 1;
+    }
+
+    void clear() {
+      storage_type().swap(m_keys);
+    }
+
+  private:
+    storage_type m_keys; //sorted keys
+    Compare m_compare; //key comparator
+  };
+
+
+  template <typename K, typename V, class Compare = std::less<K>, class Alloc = std::allocator<std::pair<K, V> > >
+  class flat_map {
+  public:
+    //types:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<K> key_allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<V> mapped_allocator_type;
+    typedef devector<K, key_allocator_type> key_storage_type;
+    typedef devector<V, mapped_allocator_type> mapped_storage_type;
+    typedef typename key_storage_type::size_type size_type;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    flat_map() {}
+
+    explicit flat_map(const Compare& comp) : m_compare(comp) {}
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_keys.size();
+    }
+
+    bool empty() const noexcept {
+      return m_keys.empty();
+    }
+
+    size_type capacity() const noexcept {
+      return m_keys.capacity();
+    }
+
+    void reserve(size_type n) {
+      m_keys.reserve(n);
+      m_values.reserve(n);
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    /*
+      Returns the mapped value of key, inserting a value initialized one if key is not present
+     */
+    V& operator[](const K& key) {
+      size_type i = lower_bound(key);
+      if (i == size() || m_compare(key, m_keys[i]))
+        priv_insert_at(i, key, V());
+      return m_values[i];
+    }
+
+    //Keys and values by position, in ascending key order. n must be smaller than size()
+    K& key_at(size_type n) {
+      return m_keys[n];
+    }
+
+    V& value_at(size_type n) {
+      return m_values[n];
+    }
+
+    //The sorted keys and their values as contiguous arrays of size() elements
+    K* keys() noexcept {
+      return m_keys.data();
+    }
+
+    V* values() noexcept {
+      return m_values.data();
+    }
+
+  /*
+  ========================================
+  Lookup
+  ========================================
+  */
+    /*
+      Returns the position of the first key not ordered before key (size() if there is none)
+     */
+    size_type lower_bound(const K& key) {
+      return detail::flat_lower_bound(m_keys.begin(), m_keys.size(), key, m_compare,
+                                      detail::is_branchless_searchable<K, Compare>()) - m_keys.begin();
+    }
+
+    /*
+      Returns the position of key, or npos if it is not present
+     */
+    size_type index_of(const K& key) {
+      size_type i = lower_bound(key);
+      if (i != size() && !m_compare(key, m_keys[i]))
+        return i;
+      return npos;
+    }
+
+    /*
+      Returns a pointer to the value mapped to key, or NULL if it is not present
+     */
+    V* find(const K& key) {
+      size_type i = index_of(key);
+      return i == npos ? NULL : &m_values[i];
+    }
+
+    size_type count(const K& key) {
+      return index_of(key) != npos;
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Inserts (key, value) if key is not present. Returns whether the insertion took place
+     */
+    bool insert(const K& key, const V& value) {
+      size_type i = lower_bound(key);
+      if (i != size() && !m_compare(key, m_keys[i]))
+        return false;
+      priv_insert_at(i, key, value);
+      return true;
+    }
+
+    /*
+      Merges the range [first, last) of std::pair<K, V>, sorted by key, into the map in O(size() + distance(first, last)).
+      Keys already present keep their value, keys repeated inside the range keep the first one.
+      Strong guarantee (the merge is built on new buffers)
+     */
+    template <class ForwardIt>
+    void insert_sorted(ForwardIt first, ForwardIt last) {
+      key_storage_type merged_keys;
+      mapped_storage_type merged_values;
+      size_type i = 0, n = m_keys.size();
+      size_type total = n + std::distance(first, last);
+      merged_keys.reserve(total);
+      merged_values.reserve(total);
+      while (i < n || first != last) {
+        const K* key;
+        const V* value;
+        if (first == last || (i < n && !m_compare(first->first, m_keys[i]))) {
+          key = &m_keys[i];
+          value = &m_values[i];
+          if (first != last && !m_compare(m_keys[i], first->first)) ++first; //same key on both sides
+          i++;
+        } else {
+          key = &first->first;
+          value = &first->second;
+          ++first;
+        }
+        if (merged_keys.empty() || m_compare(merged_keys.back(), *key)) {
+          merged_keys.push_back(*key);
+          merged_values.push_back(*value);
+        }
+      }
+      m_keys.swap(merged_keys);
+      m_values.swap(merged_values);
+    }
+
+    /*
+      The value goes first: if erasing it throws (V not nothrow relocatable) the key is still there to find it by.
+      Erasing the key then never throws for the usual key types (nothrow relocatable)
+     */
+    size_type erase(const K& key) {
+      size_type i = index_of(key);
+      if (i == npos)
+        return 0;
+      m_values.erase(m_values.begin() + i);
+      m_keys.erase(m_keys.begin() + i);
+      return 1;
+    }
+
+    void clear() {
+      key_storage_type().swap(m_keys);
+      mapped_storage_type().swap(m_values);
+    }
+
+  private:
+    key_storage_type m_keys; //sorted keys
+    mapped_storage_type m_values; //m_values[i] is the value mapped to m_keys[i]
+    Compare m_compare; //key comparator
+
+    /*
+      Both arrays are shifted the same way, as the closer end only depends on i and size()
+     */
+    void priv_insert_at(size_type i, const K& key, const V& value) {
+      m_keys.insert(m_keys.begin() + i, key);
+      try {
+        m_values.insert(m_values.begin() + i, value);
+      } catch (...) {
+        m_keys.erase(m_keys.begin() + i);
+        throw;
+      }
+    }
+  };
+
+  template <typename K, typename V, class Compare, class Alloc>
+  const typename flat_map<K, V, Compare, Alloc>::size_type flat_map<K, V, Compare, Alloc>::npos;
+};
+
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef BOOST_CONTAINER_CONTAINER_GAP_VECTOR_HPP
+#define BOOST_CONTAINER_CONTAINER_GAP_VECTOR_HPP
+
+/*
+  C++ gap buffer, built with the allocation and relocation code of boost::devector
+
+  devector keeps its free space at both ends of the buffer, so editing next to an end is cheap. A gap buffer keeps
+  it at a cursor instead, which is where text editors, log assemblers and record stream rewriters do most of their
+  edits:
+     [a b c d _ _ _ _ e f g]
+              ^ cursor (the gap)
+     + insert and erase_before / erase_after at the cursor are O(1) (amortized, the gap grows geometrically as
+       push_back does when it runs out)
+     + moving the cursor from i to j costs O(|i - j|): the elements in between jump over the gap (memmove for
+       trivially relocatable types), and nothing else moves
+     + before() and after() are the elements on each side of the gap, as contiguous spans
+     + operator[] and at() index the sequence as if there was no gap
+  So an edit at distance d from the previous one costs O(d), instead of O(size() - i) for std::vector.
+
+  The elements are moved over the gap with relocate_overlapping, which can't leave a hole halfway, so T must be
+  nothrow relocatable (trivially relocatable or nothrow move constructible).
+ */
+
+#include "devector.hpp"
+//We include vector for boost::exceptions
+#include "../vector.hpp"
+//We include iterator for std::distance
+#include <iterator>
+
+namespace boost {
+  template <typename T, class Alloc = std::allocator<T> >
+  class gap_vector {
+    static_assert(is_nothrow_relocatable<T>::value, "gap_vector needs a nothrow relocatable value_type");
+  public:
+    //types:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef value_type& reference;
+    typedef unsigned int size_type;
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    gap_vector() noexcept : m_gap_begin(0), m_gap_end(0), m_capacity(0), m_buffer(NULL) {}
+
+    ~gap_vector() noexcept {
+      priv_destroy();
+      if (m_buffer != NULL)
+        m_allocator.deallocate(m_buffer, m_capacity);
+    }
+
+    gap_vector(const gap_vector&) = delete;
+    gap_vector& operator=(const gap_vector&) = delete;
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_capacity - (m_gap_end - m_gap_begin);
+    }
+
+    bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    size_type capacity() const noexcept {
+      return m_capacity;
+    }
+
+    /*
+      Number of elements that can be inserted at the cursor without reallocating
+     */
+    size_type gap_size() const noexcept {
+      return m_gap_end - m_gap_begin;
+    }
+
+    /*
+      Makes room for at least n elements, keeping the gap at the cursor. Strong guarantee
+     */
+    void reserve(size_type n) {
+      if (n > m_capacity)
+        priv_reallocate(n);
+    }
+
+  /*
+  ========================================
+  Cursor
+  ========================================
+  */
+    /*
+      Index of the first element after the gap (== number of elements before it)
+     */
+    size_type cursor() const noexcept {
+      return m_gap_begin;
+    }
+
+    /*
+      Moves the gap before element pos (0 <= pos <= size()), in O(|pos - cursor()|). Never throws
+     */
+    void set_cursor(size_type pos) noexcept {
+      if (pos < m_gap_begin) {
+        size_type d = m_gap_begin - pos;
+        relocate_overlapping(m_allocator, m_buffer + pos, m_buffer + m_gap_begin, m_buffer + m_gap_end - d);
+        m_gap_begin -= d;
+        m_gap_end -= d;
+      } else if (pos > m_gap_begin) {
+        size_type d = pos - m_gap_begin;
+        relocate_overlapping(m_allocator, m_buffer + m_gap_end, m_buffer + m_gap_end + d, m_buffer + m_gap_begin);
+        m_gap_begin += d;
+        m_gap_end += d;
+      }
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    /*
+      No bounds checking, as for devector
+     */
+    reference operator[](size_type n) {
+      return m_buffer[n < m_gap_begin ? n : n + (m_gap_end - m_gap_begin)];
+    }
+
+    reference at(size_type n) {
+      if (n >= size())
+        throw exceptions::out_of_bounds();
+      return (*this)[n];
+    }
+
+    /*
+      The elements before (after) the gap. Both are invalidated by any insert or cursor move
+     */
+    span<T> before() noexcept {
+      return span<T>(m_buffer, m_gap_begin);
+    }
+
+    span<T> after() noexcept {
+      return span<T>(m_buffer + m_gap_end, m_capacity - m_gap_end);
+    }
+
+    /*
+      Calls f(element) for every element, in order
+     */
+    template <class F>
+    void for_each(F f) {
+      for (T* p=m_buffer; p!=m_buffer + m_gap_begin; ++p) {
+        f(*p);
+      }
+      for (T* p=m_buffer + m_gap_end; p!=m_buffer + m_capacity; ++p) {
+        f(*p);
+      }
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Inserts x at the cursor, which ends up after it (as typing does). O(1) amortized. Strong guarantee
+     */
+    void insert(const T& x) {
+      if (m_gap_begin == m_gap_end) {
+        value_type tmp(x); //x may be an element of this gap_vector, which is about to move
+        priv_grow(1);
+        m_allocator.construct(m_buffer + m_gap_begin, std::move(tmp));
+      } else {
+        m_allocator.construct(m_buffer + m_gap_begin, x);
+      }
+      m_gap_begin++;
+    }
+
+    void insert(T&& x) {
+      if (m_gap_begin == m_gap_end)
+        priv_grow(1);
+      m_allocator.construct(m_buffer + m_gap_begin, std::move(x));
+      m_gap_begin++;
+    }
+
+    /*
+      Inserts a copy of [first, last) at the cursor, which ends up after them. The range must not be part of this
+      gap_vector. Strong guarantee
+     */
+    template <class ForwardIt>
+    void insert(ForwardIt first, ForwardIt last) {
+      size_type k = std::distance(first, last);
+      if (gap_size() < k)
+        priv_grow(k);
+      T* cur = m_buffer + m_gap_begin;
+      try {
+        for (; first!=last; ++first, ++cur) {
+          m_allocator.construct(cur, *first);
+        }
+      } catch (...) {
+        for (T* p=m_buffer + m_gap_begin; p!=cur; ++p) {
+          m_allocator.destroy(p);
+        }
+        throw;
+      }
+      m_gap_begin += k;
+    }
+
+    /*
+      Erases the n elements before (after) the cursor, as backspace (delete) does. They must exist
+     */
+    void erase_before(size_type n = 1) noexcept {
+      for (size_type i=0; i<n; i++) {
+        m_allocator.destroy(m_buffer + --m_gap_begin);
+      }
+    }
+
+    void erase_after(size_type n = 1) noexcept {
+      for (size_type i=0; i<n; i++) {
+        m_allocator.destroy(m_buffer + m_gap_end++);
+      }
+    }
+
+    /*
+      Destroys every element but keeps the buffer (the whole of it becomes the gap)
+     */
+    void clear() noexcept {
+      priv_destroy();
+      m_gap_begin = 0;
+      m_gap_end = m_capacity;
+    }
+
+    void swap(gap_vector& other) noexcept {
+      std::swap(m_gap_begin, other.m_gap_begin);
+      std::swap(m_gap_end, other.m_gap_end);
+      std::swap(m_capacity, other.m_capacity);
+      std::swap(m_allocator, other.m_allocator);
+      std::swap(m_buffer, other.m_buffer);
+    }
+
+  private:
+    size_type m_gap_begin; //first position of the gap (== number of elements before it)
+    size_type m_gap_end; //first position after the gap
+    size_type m_capacity; //number of allocated elements
+    Alloc m_allocator; //allocator class
+    T* m_buffer; //elements [0, m_gap_begin) and [m_gap_end, m_capacity), NULL until the first insert
+
+    void priv_destroy() noexcept {
+      for (T* p=m_buffer; p!=m_buffer + m_gap_begin; ++p) {
+        m_allocator.destroy(p);
+      }
+      for (T* p=m_buffer + m_gap_end; p!=m_buffer + m_capacity; ++p) {
+        m_allocator.destroy(p);
+      }
+    }
+
+    /*
+      Makes the gap at least n elements wide, growing geometrically as push_back does
+     */
+    void priv_grow(size_type n) {
+      size_type grown = (m_capacity+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT);
+      priv_reallocate(grown > size() + n ? grown : size() + n);
+    }
+
+    /*
+      Moves the elements to a buffer of n elements, those before the gap to its start and those after it to its
+      end. Only the allocation can throw, and then nothing changed
+     */
+    void priv_reallocate(size_type n) {
+      value_type * pre_buffer = m_allocator.allocate(n);
+      size_type after = m_capacity - m_gap_end;
+      if (m_buffer != NULL) {
+        relocate(m_allocator, m_buffer, m_buffer + m_gap_begin, pre_buffer);
+        relocate(m_allocator, m_buffer + m_gap_end, m_buffer + m_capacity, pre_buffer + n - after);
+        m_allocator.deallocate(m_buffer, m_capacity);
+      }
+      m_buffer = pre_buffer;
+      m_gap_end = n - after;
+      m_capacity = n;
+    }
+  };
+};
+
+
+#endif
@@ -0,0 +1,329 @@
+#ifndef BOOST_CONTAINER_CONTAINER_IO_BUFFER_HPP
+#define BOOST_CONTAINER_CONTAINER_IO_BUFFER_HPP
+
+/*
+  Network buffers on top of devector
+
+  A devector keeps free space at both of its ends, which is the layout of a network packet buffer (skb, mbuf):
+  the payload is written in the middle, and every protocol layer on the way out puts its header in front of it
+  without moving the payload, while on the way in every layer strips its header off the front in O(1).
+
+     [headroom | live bytes | tailroom]
+                ^ data()
+
+  io_buffer is a byte_devector with that vocabulary:
+     + reserve_headroom / reserve_tailroom make room at one end, once, before the layers start
+     + prepend(n) returns the n bytes just before the live ones, for a header to be written in place;
+       append(n) does the same at the back. Both are O(1) while the room lasts, and grow that end geometrically
+       (moving the live bytes once) when it doesn't
+     + strip_front / strip_back drop bytes from either end in O(1)
+     + live() and tailroom_iovec() are the regions to hand to writev and readv, and commit(n) adopts the n bytes
+       readv wrote into the tailroom
+
+  For example, with TCP and IP headers in front of a payload:
+     io_buffer b(64); //room for all the headers
+     memcpy(b.append(len).data(), payload, len);
+     write_tcp_header(b.prepend(20).data());
+     write_ip_header(b.prepend(20).data());
+     iovec v = b.live(); writev(fd, &v, 1);
+
+  io_chain is a sequence of iovecs over several io_buffers, for a single writev (gathering e.g. a shared header
+  buffer and a payload buffer) or readv (scattering into the tailrooms of several buffers). It doesn't own the
+  buffers, which must stay alive and unchanged while it's in use.
+ */
+
+//We include cstring for memcpy
+#include <cstring>
+//We include cstdint for uint8_t
+#include <cstdint>
+//We include sys/uio.h for iovec
+#include <sys/uio.h>
+//We include devector for the storage of both classes
+#include "devector.hpp"
+
+namespace boost {
+  typedef devector<uint8_t> byte_devector;
+
+  class io_buffer {
+  public:
+    //types:
+    typedef uint8_t value_type;
+    typedef byte_devector::size_type size_type;
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    /*
+      An empty buffer with at least the given free room at each end
+     */
+    explicit io_buffer(size_type headroom = 0, size_type tailroom = 0) {
+      m_bytes.reserve_front(headroom);
+      m_bytes.reserve_back(tailroom);
+      m_headroom = m_bytes.front_free_capacity();
+    }
+
+    io_buffer(io_buffer&& other) noexcept : m_headroom(0) {
+      swap(other);
+    }
+
+    io_buffer& operator=(io_buffer&& other) noexcept {
+      swap(other);
+      return *this;
+    }
+
+    io_buffer(const io_buffer&) = delete;
+    io_buffer& operator=(const io_buffer&) = delete;
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_bytes.size();
+    }
+
+    bool empty() const noexcept {
+      return m_bytes.empty();
+    }
+
+    size_type headroom() const noexcept {
+      return m_bytes.front_free_capacity();
+    }
+
+    size_type tailroom() const noexcept {
+      return m_bytes.back_free_capacity();
+    }
+
+    /*
+      Makes sure at least n bytes can be prepended (appended) without moving the live bytes. Strong guarantee
+     */
+    void reserve_headroom(size_type n) {
+      m_bytes.reserve_front(n);
+      if (n > m_headroom) m_headroom = n;
+    }
+
+    void reserve_tailroom(size_type n) {
+      m_bytes.reserve_back(n);
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    uint8_t* data() noexcept {
+      return m_bytes.data();
+    }
+
+    uint8_t& operator[](size_type n) {
+      return m_bytes[n];
+    }
+
+    /*
+      The live bytes, for writev
+     */
+    iovec live() noexcept {
+      iovec v;
+      v.iov_base = data();
+      v.iov_len = size();
+      return v;
+    }
+
+    /*
+      The whole tailroom, for readv (follow it with commit)
+     */
+    iovec tailroom_iovec() noexcept {
+      iovec v;
+      v.iov_base = data() + size();
+      v.iov_len = tailroom();
+      return v;
+    }
+
+    byte_devector& bytes() noexcept {
+      return m_bytes;
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Adds n bytes in front of the live ones and returns them, uninitialized, to write a header into
+     */
+    span<uint8_t> prepend(size_type n) {
+      m_bytes.prepend_uninitialized(n);
+      m_bytes.commit_front(n);
+      return span<uint8_t>(data(), n);
+    }
+
+    void prepend(const void* p, size_type n) {
+      memcpy(prepend(n).data(), p, n);
+    }
+
+    /*
+      Adds n bytes after the live ones and returns them, uninitialized
+     */
+    span<uint8_t> append(size_type n) {
+      span<uint8_t> tail = m_bytes.append_uninitialized(n);
+      m_bytes.commit(n);
+      return tail;
+    }
+
+    void append(const void* p, size_type n) {
+      memcpy(append(n).data(), p, n);
+    }
+
+    /*
+      Adopts the first n bytes of the tailroom (written by readv or recv) as live bytes. Throws buffer_overflow if
+      n is more than the tailroom
+     */
+    void commit(size_type n) {
+      m_bytes.commit(n);
+    }
+
+    /*
+      Drops the first (last) n live bytes, which must exist. The room they leave is reused by the next prepend
+      (append). O(1): the buffer never moves, so data() of the remaining bytes and iovecs taken earlier stay valid
+     */
+    void strip_front(size_type n) noexcept {
+      m_bytes.erase_front(n);
+    }
+
+    void strip_back(size_type n) noexcept {
+      m_bytes.erase_back(n);
+    }
+
+    /*
+      Drops every byte and puts the front back at the reserved headroom, so the buffer can be refilled for the
+      next packet with all the rest of its room as tailroom
+     */
+    void clear() noexcept {
+      m_bytes.clear(m_headroom);
+    }
+
+    void swap(io_buffer& other) noexcept {
+      m_bytes.swap(other.m_bytes);
+      std::swap(m_headroom, other.m_headroom);
+    }
+
+  private:
+    byte_devector m_bytes; //the live bytes, with the headroom and tailroom around them
+    size_type m_headroom;  //the headroom reserved so far, which clear restores
+  };
+
+  class io_chain {
+  public:
+    typedef std::size_t size_type;
+
+  /*
+  ========================================
+  Gather (writev)
+  ========================================
+  */
+    /*
+      Adds the live bytes of b after (before) the ones already in the chain
+     */
+    void append(io_buffer& b) {
+      m_iov.push_back(b.live());
+      m_owners.push_back(NULL);
+    }
+
+    void prepend(io_buffer& b) {
+      m_iov.push_front(b.live());
+      m_owners.push_front(NULL);
+    }
+
+    /*
+      Drops the first n bytes of the chain, after a writev that only wrote n of them: the segments written in full
+      are removed and the next one is advanced, so data() and count() are ready for the next writev
+     */
+    void consume(size_type n) {
+      while (n > 0 && !m_iov.empty()) {
+        iovec& first = m_iov.front();
+        if (n < first.iov_len) {
+          first.iov_base = (uint8_t*)first.iov_base + n;
+          first.iov_len -= n;
+          return;
+        }
+        n -= first.iov_len;
+        m_iov.pop_front();
+        m_owners.pop_front();
+      }
+    }
+
+  /*
+  ========================================
+  Scatter (readv)
+  ========================================
+  */
+    /*
+      Adds the tailroom of b after the segments already in the chain
+     */
+    void append_tailroom(io_buffer& b) {
+      m_iov.push_back(b.tailroom_iovec());
+      m_owners.push_back(&b);
+    }
+
+    /*
+      Commits the n bytes a readv wrote into the chain to the buffers whose tailrooms they landed in, in order, and
+      drops them from the chain as consume does. Every segment up to the n-th byte must come from append_tailroom
+     */
+    void commit(size_type n) {
+      while (n > 0 && !m_iov.empty()) {
+        iovec& first = m_iov.front();
+        if (n < first.iov_len) {
+          m_owners.front()->commit(n);
+          first.iov_base = (uint8_t*)first.iov_base + n;
+          first.iov_len -= n;
+          return;
+        }
+        m_owners.front()->commit(first.iov_len);
+        n -= first.iov_len;
+        m_iov.pop_front();
+        m_owners.pop_front();
+      }
+    }
+
+  /*
+  ========================================
+  Access
+  ========================================
+  */
+    const iovec* data() noexcept {
+      return m_iov.data();
+    }
+
+    //number of iovecs, as writev and readv take it
+    int count() const noexcept {
+      return (int)m_iov.size();
+    }
+
+    size_type bytes() noexcept {
+      size_type total = 0;
+      for (iovec* v=m_iov.begin(); v!=m_iov.end(); ++v) {
+        total += v->iov_len;
+      }
+      return total;
+    }
+
+    bool empty() const noexcept {
+      return m_iov.empty();
+    }
+
+    void clear() noexcept {
+      m_iov.clear();
+      m_owners.clear();
+    }
+
+  private:
+    devector<iovec> m_iov; //the segments, in order
+    devector<io_buffer*> m_owners; //m_owners[i] is the buffer whose tailroom m_iov[i] is (NULL for live bytes)
+  };
+};
+
+
+#endif
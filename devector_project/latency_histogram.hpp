@@ -0,0 +1,114 @@
+#ifndef BOOST_CONTAINER_BENCH_LATENCY_HISTOGRAM_HPP
+#define BOOST_CONTAINER_BENCH_LATENCY_HISTOGRAM_HPP
+
+/*
+  Log-bucketed (HDR style) latency histogram used by the latency benchmarks.
+
+  Values below 2^SUB_BITS are counted exactly. Above that, every power of two range [2^m, 2^(m+1)) is split into
+  2^SUB_BITS equal sub-buckets, so any recorded value is known within 1/2^SUB_BITS (~6%) of its real value,
+  while the whole 64 bit range fits in a fixed array of counters and record() is a handful of instructions.
+ */
+
+//We include cstdint for uint64_t
+#include <cstdint>
+//We include cstring for memset
+#include <cstring>
+//We include chrono for the timestamps
+#include <chrono>
+//We include iostream and iomanip to print the reports
+#include <iostream>
+#include <iomanip>
+
+namespace boost {
+  namespace bench {
+    class latency_histogram {
+    public:
+      static const unsigned SUB_BITS = 4;
+      static const unsigned BUCKETS = (64 - SUB_BITS + 1) << SUB_BITS;
+
+      latency_histogram() {
+        reset();
+      }
+
+      void reset() {
+        memset(m_counts, 0, sizeof(m_counts));
+        m_count = 0;
+        m_max = 0;
+      }
+
+      void record(uint64_t value) {
+        m_counts[priv_index(value)]++;
+        m_count++;
+        if (value > m_max) m_max = value;
+      }
+
+      uint64_t count() const {
+        return m_count;
+      }
+
+      uint64_t max() const {
+        return m_max;
+      }
+
+      /*
+        Returns the lower bound of the bucket holding the p-th quantile (0 <= p <= 1)
+       */
+      uint64_t percentile(double p) const {
+        uint64_t target = (uint64_t)(p * m_count);
+        if (target >= m_count) return m_max;
+        uint64_t seen = 0;
+        for (unsigned i=0; i<BUCKETS; i++) {
+          seen += m_counts[i];
+          if (seen > target)
+            return priv_lower_bound(i);
+        }
+        return m_max;
+      }
+
+      /*
+        Prints one line with the usual percentiles, in the unit the values were recorded in
+       */
+      void print(std::ostream& out, const char* name) const {
+        out << std::left << std::setw(36) << name << std::right
+            << " n=" << std::setw(10) << m_count
+            << " p50=" << std::setw(8) << percentile(0.5)
+            << " p99=" << std::setw(8) << percentile(0.99)
+            << " p99.9=" << std::setw(8) << percentile(0.999)
+            << " p99.99=" << std::setw(8) << percentile(0.9999)
+            << " max=" << std::setw(10) << m_max << std::endl;
+      }
+
+    private:
+      uint64_t m_counts[BUCKETS];
+      uint64_t m_count;
+      uint64_t m_max;
+
+      static unsigned priv_index(uint64_t value) {
+        if (value < (1u << SUB_BITS))
+          return (unsigned)value;
+        unsigned msb = 63 - __builtin_clzll(value);
+        unsigned sub = (unsigned)(value >> (msb - SUB_BITS)) & ((1u << SUB_BITS) - 1);
+        return ((msb - SUB_BITS + 1) << SUB_BITS) + sub;
+      }
+
+      static uint64_t priv_lower_bound(unsigned index) {
+        if (index < (1u << SUB_BITS))
+          return index;
+        unsigned e = index >> SUB_BITS;
+        uint64_t sub = index & ((1u << SUB_BITS) - 1);
+        return ((1ull << SUB_BITS) + sub) << (e - 1);
+      }
+    };
+
+    /*
+      Nanosecond timestamps. steady_clock costs ~20ns per call, which is well below the spikes we look for.
+     */
+    inline uint64_t now_ns() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+  }
+};
+
+
+#endif
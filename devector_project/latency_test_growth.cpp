@@ -0,0 +1,136 @@
+#include "../vector.hpp"
+#include "devector.hpp"
+#include "latency_histogram.hpp"
+#include <deque>
+#include <memory>
+#include <vector>
+#ifndef MAXIMUM
+#define MAXIMUM 10000000
+#endif
+#ifndef ELEMENT_SIZE
+#define ELEMENT_SIZE 4
+#endif
+using namespace boost::bench;
+
+/*
+  Per push_back / push_front latency (in ns) of boost::vector and boost::devector against std::vector and
+  std::deque, with elements of ELEMENT_SIZE bytes. The growth of the boost containers follows VECTOR_AMORT_INC and
+  VECTOR_AMORT_MULT (see vector.hpp), the std ones use their own.
+  Every line is followed by the number of allocations the container made: for the vectors each one is a
+  reallocation that moved all the elements, and they are where the p99.9 and max spikes come from; for std::deque
+  they are the fixed size blocks plus its map of blocks, and nothing is ever moved.
+  latency_tester.sh sweeps N, ELEMENT_SIZE and the growth factors.
+
+  g++ -std=c++11 -O3 -Wall -DMAXIMUM=1000000 -DELEMENT_SIZE=64 -DVECTOR_AMORT_INC=1 -DVECTOR_AMORT_MULT=1.5f latency_test_growth.cpp -o latency_growth && ./latency_growth
+ */
+
+struct element {
+  char bytes[ELEMENT_SIZE];
+  element() {}
+  explicit element(unsigned int i) {
+    bytes[0] = (char)i;
+    bytes[ELEMENT_SIZE - 1] = (char)(i >> 8);
+  }
+};
+
+static uint64_t allocations = 0;
+
+/*
+  std::allocator that counts every allocate call, whatever it gets rebound to
+ */
+template <typename T>
+struct counting_allocator : std::allocator<T> {
+  template <typename U>
+  struct rebind {
+    typedef counting_allocator<U> other;
+  };
+  counting_allocator() {}
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&) {}
+  T* allocate(std::size_t n) {
+    allocations++;
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+static latency_histogram h;
+
+static void report(const char* name) {
+  h.print(std::cout, name);
+  std::cout << "    allocations " << allocations << std::endl;
+  h.reset();
+  allocations = 0;
+}
+
+int main() {
+  uint64_t t0, t1;
+  std::cout << "N = " << MAXIMUM << ", ELEMENT_SIZE = " << ELEMENT_SIZE
+            << ", growth (" << VECTOR_AMORT_INC << ", " << VECTOR_AMORT_MULT << ")" << std::endl;
+
+  {
+    std::vector<element, counting_allocator<element> > v;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      v.push_back(element(i));
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+  }
+  report("std::vector push_back");
+
+  {
+    boost::vector<element, counting_allocator<element> > v;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      v.pre_push_back();
+      v.push_back(element(i));
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+  }
+  report("boost::vector push_back");
+
+  {
+    std::deque<element, counting_allocator<element> > d;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      d.push_back(element(i));
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+  }
+  report("std::deque push_back");
+
+  {
+    boost::devector<element, counting_allocator<element> > d;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      d.push_back(element(i));
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+  }
+  report("boost::devector push_back");
+
+  {
+    std::deque<element, counting_allocator<element> > d;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      d.push_front(element(i));
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+  }
+  report("std::deque push_front");
+
+  {
+    boost::devector<element, counting_allocator<element> > d;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      d.push_front(element(i));
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+  }
+  report("boost::devector push_front");
+}
@@ -0,0 +1,55 @@
+#include "../vector.hpp"
+#include "../incremental_vector.hpp"
+#include "latency_histogram.hpp"
+#include <vector>
+#ifndef MAXIMUM
+#define MAXIMUM 10000000
+#endif
+using namespace boost;
+using namespace boost::bench;
+
+/*
+  Per push_back latency (in ns) of the amortized vectors against the incremental one.
+  The p50 should be about the same for all of them, the difference is in the p99.99 and max columns.
+ */
+
+int main() {
+  latency_histogram h;
+  uint64_t t0, t1;
+
+  {
+    std::vector<int> v;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      v.push_back(i);
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+    h.print(std::cout, "std::vector push_back");
+  }
+
+  h.reset();
+  {
+    boost::vector<int> v;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      v.pre_push_back();
+      v.push_back(i);
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+    h.print(std::cout, "boost::vector push_back");
+  }
+
+  h.reset();
+  {
+    incremental_vector<int> v;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      t0 = now_ns();
+      v.push_back(i);
+      t1 = now_ns();
+      h.record(t1 - t0);
+    }
+    h.print(std::cout, "boost::incremental_vector push_back");
+  }
+}
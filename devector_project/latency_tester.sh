@@ -0,0 +1,23 @@
+echo "WARNING: remove the bigger values if you dont have 4gb of ram"
+sleep 5
+echo "----------------------- PUSH_BACK LATENCY (ns), -O3 --------------------------  "
+for OPT in 100000 1000000 10000000 100000000
+do
+	echo N = $OPT
+	g++ -std=c++11 -O3 -Wall -DMAXIMUM=$OPT latency_test_incremental.cpp -o latency_incremental
+	./latency_incremental
+done
+
+echo "------------- PUSH LATENCY (ns) BY GROWTH FACTOR AND ELEMENT SIZE, -O3 -------------  "
+for GROWTH in "0 2" "1 1.5f" "0 4"
+do
+	set -- $GROWTH
+	for SIZE in 4 16 64 256
+	do
+		for OPT in 100000 1000000 10000000
+		do
+			g++ -std=c++11 -O3 -Wall -DMAXIMUM=$OPT -DELEMENT_SIZE=$SIZE -DVECTOR_AMORT_INC=$1 -DVECTOR_AMORT_MULT=$2 latency_test_growth.cpp -o latency_growth
+			./latency_growth
+		done
+	done
+done
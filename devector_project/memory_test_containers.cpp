@@ -0,0 +1,192 @@
+#include "../vector.hpp"
+#include "../incremental_vector.hpp"
+#include "devector.hpp"
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <malloc.h>
+#include <unistd.h>
+#ifndef MAXIMUM
+#define MAXIMUM 10000000
+#endif
+#ifndef ELEMENT_SIZE
+#define ELEMENT_SIZE 4
+#endif
+#ifndef FIFO_SIZE
+#define FIFO_SIZE (MAXIMUM / 16)
+#endif
+using namespace std;
+
+/*
+  Memory overhead of the containers on four workloads of MAXIMUM pushes of ELEMENT_SIZE byte elements:
+     back:    push_back only
+     front:   push_front only
+     mixed:   push_back and push_front alternated
+     fifo:    push_back, with a pop_front whenever there are more than FIFO_SIZE elements
+  For every container and workload it prints:
+     payload: the most bytes of elements alive at the same time
+     peak:    the most bytes the container had allocated at the same time (old and new buffers during a reallocation
+              both count), tracked by an allocator that counts live bytes
+     rss:     the most the resident set size (/proc/self/statm) grew over the run, sampled on every allocation and
+              deallocation; pages that were allocated but never written don't count here
+     peak / payload and rss / payload
+  The growth of the boost containers follows VECTOR_AMORT_INC and VECTOR_AMORT_MULT (see vector.hpp), and the
+  shrinking of devector on pop_front follows the VECTOR_SHRINK_* constants (off unless VECTOR_SHRINK_DIV is set).
+  memory_tester.sh sweeps them.
+
+  g++ -std=c++11 -O3 -Wall -DMAXIMUM=1000000 -DELEMENT_SIZE=16 memory_test_containers.cpp -o memory_containers && ./memory_containers
+ */
+
+struct element {
+  char bytes[ELEMENT_SIZE];
+  element() {}
+  explicit element(unsigned int i) {
+    bytes[0] = (char)i;
+    bytes[ELEMENT_SIZE - 1] = (char)(i >> 8);
+  }
+};
+
+static size_t live_bytes = 0, peak_bytes = 0;
+static size_t rss_base = 0, rss_peak = 0;
+
+/*
+  Resident set size in bytes. We use read() on a stack buffer, so sampling doesn't allocate.
+ */
+static size_t resident_bytes() {
+  char buffer[128];
+  int fd = open("/proc/self/statm", O_RDONLY);
+  if (fd < 0)
+    return 0;
+  ssize_t n = read(fd, buffer, sizeof(buffer) - 1);
+  close(fd);
+  if (n <= 0)
+    return 0;
+  buffer[n] = 0;
+  const char* p = buffer;
+  while (*p && *p != ' ') p++; //skip the total program size
+  return strtoull(p, 0, 10) * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static void sample_rss() {
+  size_t rss = resident_bytes();
+  if (rss > rss_peak) rss_peak = rss;
+}
+
+/*
+  std::allocator that tracks the live and peak bytes of everything it (or any of its rebinds) allocates
+ */
+template <typename T>
+struct tracking_allocator : std::allocator<T> {
+  template <typename U>
+  struct rebind {
+    typedef tracking_allocator<U> other;
+  };
+  tracking_allocator() {}
+  template <typename U>
+  tracking_allocator(const tracking_allocator<U>&) {}
+  T* allocate(std::size_t n) {
+    sample_rss();
+    T* p = std::allocator<T>::allocate(n);
+    live_bytes += n * sizeof(T);
+    if (live_bytes > peak_bytes) peak_bytes = live_bytes;
+    return p;
+  }
+  void deallocate(T* p, std::size_t n) {
+    sample_rss(); //a reallocation has both buffers written by now
+    std::allocator<T>::deallocate(p, n);
+    live_bytes -= n * sizeof(T);
+  }
+};
+
+/*
+  Gives the memory freed by the previous run back to the system (glibc keeps small freed chunks on its heap), so
+  that each run starts from the same rss
+ */
+static void start() {
+  malloc_trim(0);
+  live_bytes = peak_bytes = 0;
+  rss_base = rss_peak = resident_bytes();
+}
+
+static void report(const char* container, const char* workload, size_t max_elements) {
+  sample_rss();
+  double payload = (double)max_elements * sizeof(element);
+  cout << left << setw(26) << container << setw(8) << workload << right
+       << " payload " << setw(11) << (size_t)payload
+       << " peak " << setw(11) << peak_bytes
+       << " rss " << setw(11) << rss_peak - rss_base
+       << fixed << setprecision(2)
+       << "  peak/payload " << setw(5) << peak_bytes / payload
+       << "  rss/payload " << setw(5) << (rss_peak - rss_base) / payload << endl;
+}
+
+template <typename Container>
+static void back_only(Container& c) {
+  for (unsigned int i=0; i<MAXIMUM; i++) {
+    c.push_back(element(i));
+  }
+}
+
+template <typename Container>
+static void front_only(Container& c) {
+  for (unsigned int i=0; i<MAXIMUM; i++) {
+    c.push_front(element(i));
+  }
+}
+
+template <typename Container>
+static void mixed(Container& c) {
+  for (unsigned int i=0; i<MAXIMUM; i++) {
+    if (i % 2)
+      c.push_front(element(i));
+    else
+      c.push_back(element(i));
+  }
+}
+
+template <typename Container>
+static void fifo(Container& c) {
+  for (unsigned int i=0; i<MAXIMUM; i++) {
+    c.push_back(element(i));
+    if (c.size() > FIFO_SIZE)
+      c.pop_front();
+  }
+}
+
+typedef tracking_allocator<element> alloc;
+
+int main() {
+  //without a fixed threshold glibc raises it after the first big buffer is freed, and from then on big buffers come
+  //from the heap and their freed pages stay resident, which would make the first run look better than the others
+  mallopt(M_MMAP_THRESHOLD, 128 * 1024);
+  cout << "N = " << MAXIMUM << ", ELEMENT_SIZE = " << ELEMENT_SIZE << ", FIFO_SIZE = " << FIFO_SIZE
+       << ", growth (" << VECTOR_AMORT_INC << ", " << VECTOR_AMORT_MULT << ")"
+       << ", shrink (" << VECTOR_SHRINK_DIV << ", " << VECTOR_SHRINK_MULT << ")" << endl;
+  const size_t fifo_elements = (FIFO_SIZE < MAXIMUM ? FIFO_SIZE : MAXIMUM);
+
+  { start(); std::vector<element, alloc> c; back_only(c); report("std::vector", "back", MAXIMUM); }
+  { start(); std::deque<element, alloc> c; back_only(c); report("std::deque", "back", MAXIMUM); }
+  {
+    start();
+    boost::vector<element, alloc> c;
+    for (unsigned int i=0; i<MAXIMUM; i++) {
+      c.pre_push_back();
+      c.push_back(element(i));
+    }
+    report("boost::vector", "back", MAXIMUM);
+  }
+  { start(); boost::incremental_vector<element, alloc> c; back_only(c); report("boost::incremental_vector", "back", MAXIMUM); }
+  { start(); boost::devector<element, alloc> c; back_only(c); report("boost::devector", "back", MAXIMUM); }
+
+  { start(); std::deque<element, alloc> c; front_only(c); report("std::deque", "front", MAXIMUM); }
+  { start(); boost::devector<element, alloc> c; front_only(c); report("boost::devector", "front", MAXIMUM); }
+
+  { start(); std::deque<element, alloc> c; mixed(c); report("std::deque", "mixed", MAXIMUM); }
+  { start(); boost::devector<element, alloc> c; mixed(c); report("boost::devector", "mixed", MAXIMUM); }
+
+  { start(); std::deque<element, alloc> c; fifo(c); report("std::deque", "fifo", fifo_elements); }
+  { start(); boost::devector<element, alloc> c; fifo(c); report("boost::devector", "fifo", fifo_elements); }
+}
@@ -0,0 +1,23 @@
+echo "WARNING: remove the bigger values if you dont have 4gb of ram"
+sleep 5
+echo "------------------ MEMORY OVERHEAD BY GROWTH FACTOR AND ELEMENT SIZE, -O3 -------------------  "
+for GROWTH in "0 2" "1 1.5f" "0 4"
+do
+	set -- $GROWTH
+	for SIZE in 4 16 64 256
+	do
+		for OPT in 1000000 10000000
+		do
+			g++ -std=c++11 -O3 -Wall -DMAXIMUM=$OPT -DELEMENT_SIZE=$SIZE -DVECTOR_AMORT_INC=$1 -DVECTOR_AMORT_MULT=$2 memory_test_containers.cpp -o memory_containers
+			./memory_containers
+		done
+	done
+done
+
+echo "------------------------ DEVECTOR FIFO BY SHRINK POLICY, -O3 -------------------------  "
+for SHRINK in "0 2" "2 1" "4 2" "8 2"
+do
+	set -- $SHRINK
+	g++ -std=c++11 -O3 -Wall -DMAXIMUM=10000000 -DVECTOR_SHRINK_DIV=$1 -DVECTOR_SHRINK_MULT=$2 memory_test_containers.cpp -o memory_containers
+	./memory_containers | grep -e "^N =" -e fifo
+done
@@ -0,0 +1,101 @@
+#include "gap_vector.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#ifndef INITIAL
+#define INITIAL 1000000
+#endif
+#ifndef EDITS
+#define EDITS 100000
+#endif
+#ifndef STEP
+#define STEP 64
+#endif
+using namespace std;
+
+/*
+  Cursor local editing of a sequence of INITIAL ints: EDITS times, the cursor moves by a random step of at most STEP
+  positions (starting at the middle), and an element is inserted there (or, 1 time in 4, the one before it erased).
+     std::vector:      insert and erase at the cursor index, moving everything after it
+     boost::devector:  insert and erase at the cursor index, moving the shorter side
+     boost::gap_vector: set_cursor, then insert or erase_before, moving only the elements the cursor walked over
+  Times are in milliseconds.
+
+  g++ -std=c++11 -O3 -Wall speed_test_gap_vector.cpp -o gap_vector && ./gap_vector
+ */
+
+static double ms_since(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+/*
+  The same cursor positions and edits for every container
+ */
+struct edit_script {
+  mt19937 rng;
+  size_t cursor;
+  edit_script() : rng(42), cursor(INITIAL / 2) {}
+
+  //moves the cursor and returns whether the edit is an erase
+  bool next(size_t size) {
+    long step = (long)(rng() % (2 * STEP + 1)) - STEP;
+    long c = (long)cursor + step;
+    cursor = (c < 0 ? 0 : (c > (long)size ? size : (size_t)c));
+    return rng() % 4 == 0 && cursor > 0;
+  }
+};
+
+template <typename Container>
+static double run_indexed(Container& c) {
+  edit_script s;
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for (int i=0; i<EDITS; i++) {
+    if (s.next(c.size()))
+      c.erase(c.begin() + --s.cursor);
+    else
+      c.insert(c.begin() + s.cursor++, i);
+  }
+  return ms_since(t0);
+}
+
+int main() {
+  vector<int> v;
+  boost::devector<int> d;
+  boost::gap_vector<int> g;
+  for (int i=0; i<INITIAL; i++) {
+    v.push_back(-i);
+    d.push_back(-i);
+    g.insert(-i);
+  }
+
+  double vector_ms = run_indexed(v);
+  double devector_ms = run_indexed(d);
+
+  edit_script s;
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for (int i=0; i<EDITS; i++) {
+    bool erase = s.next(g.size());
+    g.set_cursor(s.cursor);
+    if (erase) {
+      g.erase_before();
+      s.cursor--;
+    } else {
+      g.insert(i);
+      s.cursor++;
+    }
+  }
+  double gap_ms = ms_since(t0);
+
+  long long v_sum = 0, d_sum = 0, g_sum = 0;
+  for (size_t i=0; i<v.size(); i+=101) {
+    v_sum += v[i];
+    d_sum += d[i];
+    g_sum += g[i];
+  }
+  cout << "N = " << INITIAL << ", " << EDITS << " edits, steps of up to " << STEP << endl;
+  cout << "std::vector      \t " << vector_ms << "\t (" << v_sum << ")" << endl;
+  cout << "boost::devector  \t " << devector_ms << "\t (" << d_sum << ")" << endl;
+  cout << "boost::gap_vector\t " << gap_ms << "\t (" << g_sum << ")" << endl;
+  return v_sum != g_sum || d_sum != g_sum;
+}
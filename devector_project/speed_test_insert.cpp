@@ -0,0 +1,61 @@
+#include "devector.hpp"
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+#ifndef MAXIMUM
+#define MAXIMUM 200000
+#endif
+using namespace std;
+
+/*
+  Middle inserts and erases of boost::devector<int> against std::vector<int> and std::deque<int>:
+     random:  MAXIMUM inserts at uniformly random positions, then MAXIMUM erases at uniformly random positions
+     front:   MAXIMUM inserts at a random position in the first 1/16 of the container
+  devector moves the shorter side of the position, so it should take about half the time of std::vector on random
+  positions, and a fraction of it near the front. Times are in milliseconds.
+
+  g++ -std=c++11 -O3 -Wall speed_test_insert.cpp -o insert && ./insert
+ */
+
+static double ms_since(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+template <typename Container>
+static void run(const char* name) {
+  mt19937 rng(42);
+  Container c;
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for (int i=0; i<MAXIMUM; i++) {
+    c.insert(c.begin() + rng() % (c.size() + 1), i);
+  }
+  double insert_ms = ms_since(t0);
+  long long sum = 0;
+  for (size_t i=0; i<c.size(); i+=97) {
+    sum += c[i];
+  }
+  t0 = chrono::steady_clock::now();
+  while (!c.empty()) {
+    c.erase(c.begin() + rng() % c.size());
+  }
+  double erase_ms = ms_since(t0);
+
+  Container f;
+  t0 = chrono::steady_clock::now();
+  for (int i=0; i<MAXIMUM; i++) {
+    f.insert(f.begin() + rng() % (f.size() / 16 + 1), i);
+  }
+  double front_ms = ms_since(t0);
+  sum += f[f.size() / 2];
+  cout << name << "\t random insert " << insert_ms << "\t random erase " << erase_ms
+       << "\t front insert " << front_ms << "\t (" << sum << ")" << endl;
+}
+
+int main() {
+  cout << "N = " << MAXIMUM << endl;
+  run<vector<int> >("std::vector    ");
+  run<deque<int> >("std::deque     ");
+  run<boost::devector<int> >("boost::devector");
+}
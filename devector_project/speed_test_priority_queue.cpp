@@ -0,0 +1,78 @@
+#include "../priority_queue.hpp"
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <random>
+#ifndef MAXIMUM
+#define MAXIMUM 1000000
+#endif
+using namespace std;
+
+/*
+  std::priority_queue against boost::priority_queue of arity 4, 8 and 16 on MAXIMUM ints:
+     push:      MAXIMUM pushes of random keys
+     pop_push:  MAXIMUM scheduler steps (pop the top, push a later key) on the full queue
+     pop:       MAXIMUM pops
+     push_range (boost only): the same keys bulk loaded with the O(n) heapify
+  Times are in milliseconds.
+
+  for N in 1000000 10000000 100000000; do g++ -std=c++11 -O3 -Wall -DMAXIMUM=$N speed_test_priority_queue.cpp -o priority_queue && ./priority_queue; done
+ */
+
+static double ms_since(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+template <class Q>
+void run(const char* name, const vector<int>& keys) {
+  Q q;
+  long long sink = 0;
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for (size_t i=0; i<keys.size(); i++) {
+    q.push(keys[i]);
+  }
+  double push = ms_since(t0);
+  t0 = chrono::steady_clock::now();
+  for (size_t i=0; i<keys.size(); i++) {
+    int top = q.top();
+    q.pop();
+    q.push(top - keys[i] % 1024);
+  }
+  double pop_push = ms_since(t0);
+  t0 = chrono::steady_clock::now();
+  while (!q.empty()) {
+    sink += q.top();
+    q.pop();
+  }
+  double pop = ms_since(t0);
+  cout << name << "\t push " << push << "\t pop_push " << pop_push << "\t pop " << pop << "\t (" << (sink & 1) << ")" << endl;
+}
+
+template <unsigned D>
+void run_boost(const char* name, const vector<int>& keys) {
+  typedef boost::priority_queue<int, less<int>, D> Q;
+  run<Q>(name, keys);
+  Q q;
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  q.push_range(keys.begin(), keys.end());
+  double range = ms_since(t0);
+  t0 = chrono::steady_clock::now();
+  for (size_t i=0; i<keys.size(); i++) {
+    q.replace_top(q.top() - keys[i] % 1024);
+  }
+  double replace = ms_since(t0);
+  cout << name << "\t push_range " << range << "\t replace_top " << replace << endl;
+}
+
+int main() {
+  vector<int> keys(MAXIMUM);
+  mt19937 rng(42);
+  for (size_t i=0; i<keys.size(); i++) {
+    keys[i] = (int)(rng() >> 1);
+  }
+  cout << "N = " << MAXIMUM << endl;
+  run<std::priority_queue<int> >("std::priority_queue      ", keys);
+  run_boost<4>("boost::priority_queue<4> ", keys);
+  run_boost<8>("boost::priority_queue<8> ", keys);
+  run_boost<16>("boost::priority_queue<16>", keys);
+}
@@ -0,0 +1,81 @@
+#include "../vector.hpp"
+#include "devector.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#ifndef MAXIMUM
+#define MAXIMUM 1000000
+#endif
+using namespace std;
+
+/*
+  Cost of growing by push_back (so mostly of relocating to the new buffers) for:
+     pod:        a trivially copyable 16 byte struct (memcpy)
+     string:     std::string, which is not trivially relocatable (move constructor)
+     unique_ptr: std::unique_ptr<int>, marked trivially relocatable (memcpy)
+     boxed_ptr:  a struct holding a std::unique_ptr<int>, not marked (move constructor)
+  in boost::vector, boost::devector and std::vector. Times are in milliseconds, for MAXIMUM push_backs.
+
+  for N in 1000000 10000000; do g++ -std=c++11 -O3 -Wall -DMAXIMUM=$N speed_test_relocate.cpp -o relocate && ./relocate; done
+ */
+
+struct pod { int a, b, c, d; };
+struct boxed_ptr { unique_ptr<int> p; };
+
+static pod make(pod*, int i) { pod x = {i, i, i, i}; return x; }
+static string make(string*, int i) { return to_string(i); }
+static unique_ptr<int> make(unique_ptr<int>*, int i) { return unique_ptr<int>(new int(i)); }
+static boxed_ptr make(boxed_ptr*, int i) { boxed_ptr x; x.p.reset(new int(i)); return x; }
+
+static double ms_since(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+template <typename T>
+double time_boost_vector() {
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  boost::vector<T> v;
+  for (int i=0; i<MAXIMUM; i++) {
+    v.pre_push_back();
+    v.push_back(make((T*)NULL, i));
+  }
+  return ms_since(t0);
+}
+
+template <typename T>
+double time_boost_devector() {
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  boost::devector<T> v;
+  for (int i=0; i<MAXIMUM; i++) {
+    v.push_back(make((T*)NULL, i));
+  }
+  return ms_since(t0);
+}
+
+template <typename T>
+double time_std_vector() {
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  std::vector<T> v;
+  for (int i=0; i<MAXIMUM; i++) {
+    v.push_back(make((T*)NULL, i));
+  }
+  return ms_since(t0);
+}
+
+template <typename T>
+void run(const char* name) {
+  cout << name << "\t trivially relocatable " << boost::is_trivially_relocatable<T>::value
+       << "\t boost::vector " << time_boost_vector<T>()
+       << "\t boost::devector " << time_boost_devector<T>()
+       << "\t std::vector " << time_std_vector<T>() << endl;
+}
+
+int main() {
+  cout << "N = " << MAXIMUM << endl;
+  run<pod>("pod       ");
+  run<string>("string    ");
+  run<unique_ptr<int> >("unique_ptr");
+  run<boxed_ptr>("boxed_ptr ");
+}
@@ -0,0 +1,100 @@
+#include "../vector.hpp"
+#include "../snapshot_vector.hpp"
+#include <pthread.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#ifndef MAXIMUM
+#define MAXIMUM 1000000
+#endif
+#ifndef MILLISECONDS
+#define MILLISECONDS 1000
+#endif
+using namespace boost;
+
+/*
+  Reader scaling: one writer keeps appending (and clearing every MAXIMUM elements) while R readers repeatedly read
+  the size and the last element. Prints the total number of reads per second for R = 1, 2, 4, ... hardware threads,
+  for a pthread_rwlock guarded boost::vector and for snapshot_vector.
+
+  g++ -std=c++11 -O3 -Wall -pthread speed_test_snapshot_vector.cpp -o snapshot_vector && ./snapshot_vector
+ */
+
+struct rwlock_vector {
+  pthread_rwlock_t lock;
+  boost::vector<int> v;
+  rwlock_vector() { pthread_rwlock_init(&lock, NULL); }
+  ~rwlock_vector() { pthread_rwlock_destroy(&lock); }
+
+  void push_back(int x) {
+    pthread_rwlock_wrlock(&lock);
+    if (v.size() >= MAXIMUM) v.clear();
+    v.pre_push_back();
+    v.push_back(x);
+    pthread_rwlock_unlock(&lock);
+  }
+
+  long long read() {
+    pthread_rwlock_rdlock(&lock);
+    long long r = v.empty() ? 0 : v.back() + v.size();
+    pthread_rwlock_unlock(&lock);
+    return r;
+  }
+};
+
+struct rcu_vector {
+  snapshot_vector<int> v;
+
+  void push_back(int x) {
+    if (v.size() >= MAXIMUM) v.clear();
+    v.push_back(x);
+  }
+
+  long long read() {
+    snapshot_vector<int>::snapshot s = v.read();
+    return s.empty() ? 0 : s.data()[s.size()-1] + s.size();
+  }
+};
+
+template <class V>
+double run(unsigned readers) {
+  V v;
+  std::atomic<bool> done(false);
+  std::atomic<long long> reads(0);
+  std::vector<std::thread> threads;
+  for (unsigned r=0; r<readers; r++) {
+    threads.push_back(std::thread([&]() {
+      long long count = 0, sink = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        sink += v.read();
+        count++;
+      }
+      reads += count + (sink == 42);
+    }));
+  }
+  std::thread writer([&]() {
+    int i = 0;
+    while (!done.load(std::memory_order_relaxed)) {
+      v.push_back(i++);
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(MILLISECONDS));
+  done = true;
+  writer.join();
+  for (unsigned r=0; r<readers; r++) {
+    threads[r].join();
+  }
+  return reads * 1000.0 / MILLISECONDS;
+}
+
+int main() {
+  unsigned hw = std::thread::hardware_concurrency();
+  if (hw < 2) hw = 2;
+  std::cout << "readers  rwlock+boost::vector (reads/s)  snapshot_vector (reads/s)" << std::endl;
+  for (unsigned r=1; r<=hw; r*=2) {
+    double locked = run<rwlock_vector>(r);
+    double rcu = run<rcu_vector>(r);
+    std::cout << r << "\t " << (long long)locked << "\t\t\t " << (long long)rcu << std::endl;
+  }
+}
@@ -0,0 +1,118 @@
+#include "work_stealing_deque.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#ifndef FIB
+#define FIB 40
+#endif
+#ifndef CUTOFF
+#define CUTOFF 20
+#endif
+using namespace std;
+
+/*
+  Fork-join scaling: computes fib(FIB) by recursive task splitting on W = 1, 2, 4, ... hardware threads workers,
+  each owning a work_stealing_deque<int> of pending fib arguments.
+  A worker running fib(n) forks fib(n - 1) (pushes it on its own deque) and goes on with fib(n - 2) itself, down to
+  n < CUTOFF, which is computed sequentially and added to the worker's own sum. The join is a global count of
+  pending tasks, and idle workers steal from random victims until it reaches zero.
+  Prints the time and the speedup over W = 1 for each W (-DWORKERS=n overrides the number of hardware threads).
+
+  g++ -std=c++11 -O3 -Wall -pthread speed_test_work_stealing.cpp -o work_stealing && ./work_stealing
+ */
+
+static long long fib_seq(int n) {
+  return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2);
+}
+
+struct worker {
+  boost::work_stealing_deque<int> deque;
+  long long sum;
+  char padding[64];
+  worker() : sum(0) {}
+};
+
+struct scheduler {
+  vector<unique_ptr<worker> > workers;
+  atomic<long long> pending;
+
+  explicit scheduler(unsigned w) : pending(0) {
+    for (unsigned i=0; i<w; i++) {
+      workers.push_back(unique_ptr<worker>(new worker()));
+    }
+  }
+
+  void run_task(worker& self, int n) {
+    while (n >= CUTOFF) {
+      pending.fetch_add(1, memory_order_relaxed);
+      self.deque.push(n - 1);
+      n -= 2;
+    }
+    self.sum += fib_seq(n);
+    pending.fetch_sub(1, memory_order_release);
+  }
+
+  void work(unsigned id) {
+    worker& self = *workers[id];
+    unsigned long long seed = id * 0x9E3779B97F4A7C15ull + 1;
+    int n;
+    while (pending.load(memory_order_acquire) != 0) {
+      if (self.deque.pop(n)) {
+        run_task(self, n);
+        continue;
+      }
+      seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+      unsigned victim = (unsigned)(seed % workers.size());
+      if (victim != id && workers[victim]->deque.steal(n))
+        run_task(self, n);
+      else
+        this_thread::yield();
+    }
+  }
+
+  long long run(int n) {
+    pending.store(1);
+    workers[0]->deque.push(n);
+    vector<thread> threads;
+    for (unsigned i=1; i<workers.size(); i++) {
+      threads.push_back(thread(&scheduler::work, this, i));
+    }
+    work(0);
+    for (size_t i=0; i<threads.size(); i++) {
+      threads[i].join();
+    }
+    long long total = 0;
+    for (size_t i=0; i<workers.size(); i++) {
+      total += workers[i]->sum;
+    }
+    return total;
+  }
+};
+
+int main() {
+#ifdef WORKERS
+  unsigned hardware = WORKERS;
+#else
+  unsigned hardware = thread::hardware_concurrency();
+  if (hardware == 0)
+    hardware = 1;
+#endif
+  double base = 0;
+  cout << "fib(" << FIB << "), cutoff " << CUTOFF << ", " << hardware << " hardware threads" << endl;
+  for (unsigned w=1; ; w*=2) {
+    if (w > hardware)
+      w = hardware;
+    scheduler s(w);
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    long long result = s.run(FIB);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    if (w == 1)
+      base = ms;
+    cout << "workers " << w << "\t ms " << ms << "\t speedup " << base / ms << "\t (" << result << ")" << endl;
+    if (w == hardware)
+      break;
+  }
+}
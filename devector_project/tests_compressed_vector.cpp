@@ -0,0 +1,145 @@
+#include "compressed_vector.hpp"
+#include <cstdint>
+#include <deque>
+#include <vector>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleCompressedVector
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for compressed_vector and its bit packing
+ */
+
+//Tests that unpack_block returns the prefix sums of the deltas packed by pack_block, for every width, plain and zigzag
+BOOST_AUTO_TEST_CASE(packed_block_all_widths) {
+  uint32_t deltas[128], codes[128], words[128], decoded[128];
+  for (unsigned bits=1; bits<=32; bits++) {
+    uint32_t mask = (bits == 32 ? 0xFFFFFFFFu : (1u << bits) - 1);
+    for (int zigzag=0; zigzag<2; zigzag++) {
+      for (unsigned i=0; i<128; i++) {
+        codes[i] = (i * 2654435761u) & mask;
+        deltas[i] = (zigzag ? (codes[i] >> 1) ^ (0u - (codes[i] & 1)) : codes[i]);
+        BOOST_CHECK(!zigzag || boost::detail::zigzag_encode(deltas[i])==codes[i]);
+      }
+      boost::detail::pack_block(codes, bits, words);
+      boost::detail::unpack_block(words, bits, zigzag, decoded);
+      int wrong = 0;
+      uint32_t total = 0;
+      for (unsigned i=0; i<128; i++) {
+        total += deltas[i];
+        wrong += (decoded[i] != total);
+      }
+      BOOST_CHECK(wrong==0);
+    }
+  }
+}
+
+//Tests compressed_vector<uint32_t> with sorted values pushed at both ends
+BOOST_AUTO_TEST_CASE(compressed_vector_uint32_sorted) {
+  boost::compressed_vector<uint32_t> cv;
+  std::vector<uint32_t> expected;
+  for (uint32_t i=0; i<1000; i++) {
+    cv.push_back(1000000 + i * 3);
+  }
+  for (uint32_t i=1; i<=500; i++) {
+    cv.push_front(1000000 - i * 5);
+  }
+  for (uint32_t i=500; i>=1; i--) {
+    expected.push_back(1000000 - i * 5);
+  }
+  for (uint32_t i=0; i<1000; i++) {
+    expected.push_back(1000000 + i * 3);
+  }
+  BOOST_CHECK(cv.size()==1500);
+  BOOST_CHECK(cv.block_count()==1000 / 128 + 500 / 128);
+  int wrong = 0;
+  for (uint32_t i=0; i<cv.size(); i++) {
+    wrong += (cv[i] != expected[i]);
+  }
+  BOOST_CHECK(wrong==0);
+  std::vector<uint32_t> decoded(cv.size());
+  cv.copy_to(&decoded[0]);
+  BOOST_CHECK(decoded==expected);
+  unsigned long long sum = 0, expected_sum = 0;
+  cv.for_each([&](uint32_t x) { sum += x; });
+  for (size_t i=0; i<expected.size(); i++) {
+    expected_sum += expected[i];
+  }
+  BOOST_CHECK(sum==expected_sum);
+  //deltas of 3 and 5 need 2 and 3 bits instead of 32 (the 220 staged values still take 4 bytes each)
+  BOOST_CHECK(cv.memory_bytes() < 1500 * sizeof(uint32_t) / 3);
+  BOOST_CHECK_THROW(cv.at(1500), boost::exceptions::out_of_bounds);
+  cv.clear();
+  BOOST_CHECK(cv.empty());
+}
+
+//Tests constant blocks, wide 64 bit ranges and negative values
+BOOST_AUTO_TEST_CASE(compressed_vector_int64_ranges) {
+  boost::compressed_vector<int64_t> cv;
+  std::vector<int64_t> expected;
+  for (int i=0; i<128; i++) {
+    expected.push_back(42); //0 bits
+  }
+  for (int i=0; i<128; i++) {
+    expected.push_back(i % 2 ? INT64_MAX - i : INT64_MIN + i); //raw 64 bit offsets
+  }
+  for (int i=0; i<256; i++) {
+    expected.push_back(-1000 + (i * 7919) % 2000); //negative bases, zigzag coded deltas
+  }
+  for (int i=0; i<128; i++) {
+    expected.push_back((int64_t)1 << 40 | (i % 2 ? (int64_t)1 << 31 : 0)); //offsets just out of the 32 bit range
+  }
+  for (int i=0; i<128; i++) {
+    int64_t offset = (i == 0 ? 0 : (i % 2 ? INT32_MAX : INT32_MIN));
+    expected.push_back(((int64_t)1 << 40) + offset); //and just in it, from the first value of the block
+  }
+  for (int i=0; i<50; i++) {
+    expected.push_back(-i); //staged
+  }
+  for (size_t i=0; i<expected.size(); i++) {
+    cv.push_back(expected[i]);
+  }
+  BOOST_CHECK(cv.size()==expected.size());
+  int wrong = 0;
+  for (size_t i=0; i<expected.size(); i++) {
+    wrong += (cv[i] != expected[i]);
+  }
+  BOOST_CHECK(wrong==0);
+  std::vector<int64_t> decoded(cv.size());
+  cv.copy_to(&decoded[0]);
+  BOOST_CHECK(decoded==expected);
+}
+
+//Tests unsorted values (zigzag blocks), and random access that keeps the decoded block across push_front
+BOOST_AUTO_TEST_CASE(compressed_vector_int32_unsorted) {
+  boost::compressed_vector<int32_t> cv;
+  std::deque<int32_t> expected;
+  unsigned seed = 3;
+  int32_t x = 0;
+  for (int i=0; i<2000; i++) {
+    seed = seed * 1103515245 + 12345;
+    x += (int32_t)((seed >> 8) % 201) - 100; //steps of -100 to 100
+    if (i % 3) {
+      cv.push_back(x);
+      expected.push_back(x);
+    } else {
+      cv.push_front(x);
+      expected.push_front(x);
+    }
+    if (i % 100 == 0)
+      BOOST_CHECK(cv[cv.size() / 2]==expected[expected.size() / 2]);
+  }
+  int wrong = 0;
+  for (size_t i=0; i<expected.size(); i++) {
+    wrong += (cv[i] != expected[i]);
+  }
+  for (size_t i=expected.size(); i-->0; ) {
+    wrong += (cv[i] != expected[i]);
+  }
+  BOOST_CHECK(wrong==0);
+  //the extremes of int32_t wrap around in the deltas
+  boost::compressed_vector<int32_t> extremes;
+  for (int i=0; i<256; i++) {
+    extremes.push_back(i % 2 ? INT32_MAX : INT32_MIN);
+  }
+  BOOST_CHECK(extremes[0]==INT32_MIN && extremes[1]==INT32_MAX && extremes[255]==INT32_MAX);
+}
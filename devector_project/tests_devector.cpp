@@ -0,0 +1,317 @@
+//The automatic shrink is opt in, these tests cover it
+#define VECTOR_SHRINK_DIV 4
+#include "devector.hpp"
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleDevector
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for devector<int>, devector<uint8_t> and devector<string>
+ */
+
+//Tests devector<int> push_front, push_back, pop_front and pop_back
+BOOST_AUTO_TEST_CASE(devector_int_push_pop) {
+  boost::devector<int> vi;
+  BOOST_CHECK(vi.size()==0);
+  BOOST_CHECK(vi.capacity()==1);
+  for (int i=0; i<100; i++) {
+    vi.push_back(i);
+    vi.push_front(-i);
+  }
+  BOOST_CHECK(vi.size()==200);
+  BOOST_CHECK(vi.front()==-99);
+  BOOST_CHECK(vi.back()==99);
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK(vi[i]==i-99);
+    BOOST_CHECK(vi[100+i]==i);
+  }
+  vi.pop_front();
+  vi.pop_back();
+  BOOST_CHECK(vi.size()==198);
+  BOOST_CHECK(vi.front()==-98);
+  BOOST_CHECK(vi.back()==98);
+}
+
+//Tests devector<int> resize, shrink_to_fit and clear
+BOOST_AUTO_TEST_CASE(devector_int_resize) {
+  boost::devector<int> vi;
+  for (int i=0; i<10; i++) {
+    vi.push_front(i);
+  }
+  vi.resize(20);
+  BOOST_CHECK(vi.size()==20);
+  BOOST_CHECK(vi[0]==9);
+  BOOST_CHECK(vi[9]==0);
+  BOOST_CHECK(vi[19]==0);
+  vi.resize(5);
+  BOOST_CHECK(vi.size()==5);
+  BOOST_CHECK(vi.back()==5);
+  vi.shrink_to_fit();
+  BOOST_CHECK(vi.capacity()==5);
+  BOOST_CHECK(vi[0]==9);
+  BOOST_CHECK(vi[4]==5);
+  vi.push_back(1);
+  vi.push_front(2);
+  BOOST_CHECK(vi.size()==7);
+  boost::devector<int>::size_type capacity = vi.capacity();
+  vi.clear();
+  BOOST_CHECK(vi.empty());
+  BOOST_CHECK(vi.capacity()==capacity);
+  vi.shrink_to_fit();
+  BOOST_CHECK(vi.capacity()==1);
+  vi.push_front(1);
+  BOOST_CHECK(vi.front()==1);
+}
+
+//Tests the automatic shrink and its hysteresis when popping from both ends
+BOOST_AUTO_TEST_CASE(devector_int_auto_shrink) {
+  boost::devector<int> vi;
+  for (int i=0; i<40000; i++) {
+    vi.push_back(i);
+  }
+  boost::devector<int>::size_type peak = vi.capacity();
+  while (vi.size() * VECTOR_SHRINK_DIV >= peak) {
+    vi.pop_front();
+  }
+  BOOST_CHECK(vi.capacity()==vi.size() * VECTOR_SHRINK_MULT);
+  boost::devector<int>::size_type shrunk = vi.capacity();
+  //pushing and popping around the threshold doesn't reallocate
+  for (int i=0; i<100; i++) {
+    vi.push_back(i);
+    vi.pop_back();
+  }
+  BOOST_CHECK(vi.capacity()==shrunk);
+  int first = vi.front();
+  for (boost::devector<int>::size_type i=0; i<vi.size(); i++) {
+    BOOST_CHECK(vi[i]==first + (int)i);
+  }
+  while (vi.size() > 0) {
+    vi.pop_back();
+  }
+  BOOST_CHECK(vi.capacity()==VECTOR_SHRINK_MIN_BYTES / sizeof(int));
+}
+
+//Tests that the automatic shrink keeps the room reserved with reserve, reserve_front and reserve_back
+BOOST_AUTO_TEST_CASE(devector_int_auto_shrink_keeps_reserved) {
+  boost::devector<int> vi;
+  vi.reserve(100000);
+  boost::devector<int>::size_type capacity = vi.capacity();
+  for (int cycle=0; cycle<2; cycle++) {
+    for (int i=0; i<100000; i++) {
+      if (i % 2)
+        vi.push_front(i);
+      else
+        vi.push_back(i);
+    }
+    while (!vi.empty()) {
+      vi.pop_front();
+    }
+    BOOST_CHECK(vi.capacity()==capacity);
+  }
+  boost::devector<int> ends;
+  ends.reserve_front(20000);
+  ends.reserve_back(20000);
+  capacity = ends.capacity();
+  for (int i=0; i<20000; i++) {
+    ends.push_front(i);
+  }
+  while (!ends.empty()) {
+    ends.pop_back();
+  }
+  BOOST_CHECK(ends.capacity()==capacity);
+  //shrink_to_fit gives the reserved room back
+  ends.shrink_to_fit();
+  BOOST_CHECK(ends.capacity()==1);
+}
+
+//Tests that erase_front and erase_back don't shrink the buffer, even far below the automatic shrink threshold
+BOOST_AUTO_TEST_CASE(devector_string_erase_ends) {
+  boost::devector<std::string> vs;
+  for (int i=0; i<10000; i++) {
+    vs.push_back(std::to_string(i));
+  }
+  boost::devector<std::string>::size_type capacity = vs.capacity(), front_free = vs.front_free_capacity();
+  std::string* data = vs.data();
+  vs.erase_front(9000);
+  vs.erase_back(990);
+  BOOST_CHECK(vs.capacity()==capacity && vs.data()==data + 9000);
+  BOOST_CHECK(vs.size()==10 && vs.front()=="9000" && vs.back()=="9009");
+  BOOST_CHECK(vs.front_free_capacity()==front_free + 9000);
+  vs.erase_back(10);
+  BOOST_CHECK(vs.empty() && vs.capacity()==capacity);
+}
+
+//Tests that big buffers keep their capacity and release pages instead of reallocating
+BOOST_AUTO_TEST_CASE(devector_int_auto_shrink_madvise) {
+  boost::devector<int> vi;
+  for (int i=0; i<(1 << 19); i++) {
+    vi.push_back(i);
+  }
+  boost::devector<int>::size_type capacity = vi.capacity();
+  int* data = vi.data();
+  while (vi.size() > 1000) {
+    vi.pop_back();
+  }
+  BOOST_CHECK(vi.capacity()==capacity);
+  BOOST_CHECK(vi.data()==data);
+  for (int i=0; i<1000; i++) {
+    BOOST_CHECK(vi[i]==i);
+  }
+  for (int i=1000; i<(1 << 19); i++) {
+    vi.push_back(i);
+  }
+  BOOST_CHECK(vi[(1 << 19) - 1]==(1 << 19) - 1);
+}
+
+//Tests devector<string> growth at both ends (strings are not trivially relocatable, so they are moved)
+BOOST_AUTO_TEST_CASE(devector_string_push_pop) {
+  boost::devector<std::string> vs;
+  for (int i=0; i<300; i++) {
+    vs.push_back(std::string(i % 40, 'b') + std::to_string(i));
+    vs.push_front(std::to_string(i));
+  }
+  BOOST_CHECK(vs.size()==600);
+  BOOST_CHECK(vs.front()=="299");
+  BOOST_CHECK(vs.back()==std::string(299 % 40, 'b') + "299");
+  while (vs.size() > 4) {
+    vs.pop_back();
+  }
+  vs.shrink_to_fit();
+  BOOST_CHECK(vs[0]=="299" && vs[3]=="296");
+  vs.resize(6);
+  BOOST_CHECK(vs[5].empty());
+}
+
+//Tests writing bytes into both ends of a devector<uint8_t> without constructing them first
+BOOST_AUTO_TEST_CASE(devector_byte_uninitialized) {
+  boost::devector<uint8_t> d;
+  const char body[] = "payload";
+  for (int i=0; i<100; i++) {
+    boost::span<uint8_t> tail = d.append_uninitialized(64);
+    memcpy(tail.data(), body, sizeof(body) - 1);
+    d.commit(sizeof(body) - 1);
+  }
+  BOOST_CHECK(d.size()==700);
+  for (int i=0; i<50; i++) {
+    boost::span<uint8_t> head = d.prepend_uninitialized(16);
+    BOOST_CHECK(head.data() + head.size()==d.data());
+    head[head.size() - 2] = 'h';
+    head[head.size() - 1] = (uint8_t)i;
+    d.commit_front(2);
+  }
+  BOOST_CHECK(d.size()==800);
+  BOOST_CHECK(d[0]=='h' && d[1]==49);
+  BOOST_CHECK(d[98]=='h' && d[99]==0);
+  BOOST_CHECK(memcmp(d.data() + 100, body, sizeof(body) - 1)==0);
+  BOOST_CHECK(memcmp(d.data() + 793, body, sizeof(body) - 1)==0);
+  d.resize_default_init(900);
+  BOOST_CHECK(d.size()==900);
+  BOOST_CHECK(d[799]=='d');
+  //committing more than the free room throws, as vector::commit does, and changes nothing
+  BOOST_CHECK_THROW(d.commit(d.back_free_capacity() + 1), boost::exceptions::buffer_overflow);
+  BOOST_CHECK_THROW(d.commit_front(d.front_free_capacity() + 1), boost::exceptions::buffer_overflow);
+  BOOST_CHECK(d.size()==900 && d[0]=='h');
+  BOOST_CHECK_NO_THROW(d.commit(d.back_free_capacity()));
+  BOOST_CHECK_NO_THROW(d.commit_front(d.front_free_capacity()));
+  BOOST_CHECK(d.size()==d.capacity());
+}
+
+//Tests devector<int> insert and erase at random positions against std::vector, and that they move the shorter side
+BOOST_AUTO_TEST_CASE(devector_int_insert_erase) {
+  boost::devector<int> d;
+  std::vector<int> expected;
+  unsigned seed = 1;
+  for (int i=0; i<2000; i++) {
+    seed = seed * 1103515245 + 12345;
+    unsigned pos = (seed >> 8) % (expected.size() + 1);
+    if (i % 3 == 2 && pos < expected.size()) {
+      boost::devector<int>::iterator it = d.erase(d.begin() + pos);
+      expected.erase(expected.begin() + pos);
+      BOOST_CHECK(it==d.begin() + pos);
+    } else {
+      BOOST_CHECK(*d.insert(d.begin() + pos, i)==i);
+      expected.insert(expected.begin() + pos, i);
+    }
+  }
+  BOOST_CHECK(d.size()==expected.size());
+  BOOST_CHECK(std::equal(expected.begin(), expected.end(), d.begin()));
+  //with room at both ends, an insert near the front leaves the back in place, and the other way around
+  d.reserve(3 * d.size()); //below the automatic shrink threshold
+  int* back = &d.back();
+  int* front = &d.front();
+  d.insert(d.begin() + 2, -1);
+  BOOST_CHECK(&d.back()==back && &d.front()==front - 1);
+  d.insert(d.end() - 2, -2);
+  BOOST_CHECK(&d.back()==back + 1 && &d.front()==front - 1);
+  d.erase(d.begin() + 1, d.begin() + 4);
+  BOOST_CHECK(&d.front()==front + 2 && d[1]==expected[3]);
+  int values[] = {7, 8, 9};
+  BOOST_CHECK(*d.insert(d.begin() + 1, values, values + 3)==7);
+  BOOST_CHECK(d[0]==expected[0] && d[1]==7 && d[3]==9 && d[4]==expected[3]);
+  int* after = d.erase(d.end() - 3, d.end());
+  BOOST_CHECK(after==d.end() && d.size()==expected.size() - 1);
+}
+
+//Tests devector<string> insert and erase, including inserting a copy of one of its own elements
+BOOST_AUTO_TEST_CASE(devector_string_insert_erase) {
+  boost::devector<std::string> vs;
+  for (int i=0; i<100; i++) {
+    vs.push_back(std::string(20, 'a') + std::to_string(i));
+  }
+  for (int i=0; i<100; i++) {
+    vs.insert(vs.begin() + 50, vs[i % 7]);
+  }
+  BOOST_CHECK(vs.size()==200);
+  BOOST_CHECK(vs[50]==std::string(20, 'a') + "1");
+  BOOST_CHECK(vs[149]==std::string(20, 'a') + "0" && vs[150]==std::string(20, 'a') + "50");
+  std::vector<std::string> more(10, "more");
+  vs.insert(vs.begin() + 190, more.begin(), more.end());
+  BOOST_CHECK(vs.size()==210 && vs[190]=="more" && vs[199]=="more" && vs[200]==std::string(20, 'a') + "90");
+  vs.erase(vs.begin() + 3, vs.begin() + 203);
+  BOOST_CHECK(vs.size()==10);
+  BOOST_CHECK(vs[2]==std::string(20, 'a') + "2" && vs[3]==std::string(20, 'a') + "93");
+}
+
+struct throwing_copy {
+  static int live;
+  static int copies_left;
+  int value;
+  throwing_copy(int v) : value(v) { live++; }
+  throwing_copy(const throwing_copy& o) : value(o.value) {
+    if (copies_left-- == 0)
+      throw std::bad_alloc();
+    live++;
+  }
+  throwing_copy& operator=(const throwing_copy& o) { value = o.value; return *this; }
+  ~throwing_copy() { live--; }
+};
+int throwing_copy::live = 0;
+int throwing_copy::copies_left = -1;
+
+//Tests that insert leaves the devector untouched when copying an element that can't be moved safely throws
+BOOST_AUTO_TEST_CASE(devector_insert_strong_guarantee) {
+  {
+    boost::devector<throwing_copy> d;
+    for (int i=0; i<20; i++) {
+      d.push_back(throwing_copy(i));
+    }
+    throwing_copy* data = d.begin();
+    throwing_copy::copies_left = 5;
+    BOOST_CHECK_THROW(d.insert(d.begin() + 10, throwing_copy(-1)), std::bad_alloc);
+    throwing_copy::copies_left = -1;
+    BOOST_CHECK(d.size()==20 && d.begin()==data);
+    for (int i=0; i<20; i++) {
+      BOOST_CHECK(d[i].value==i);
+    }
+    d.insert(d.begin() + 10, throwing_copy(-1));
+    d.erase(d.begin() + 3, d.begin() + 5);
+    BOOST_CHECK(d.size()==19 && d[3].value==5 && d[8].value==-1 && d[18].value==19);
+    d.erase(d.begin() + 15);
+    BOOST_CHECK(d.size()==18 && d[15].value==17);
+  }
+  BOOST_CHECK(throwing_copy::live==0);
+}
@@ -0,0 +1,170 @@
+#include "flat_map.hpp"
+#include <string>
+#include <vector>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleFlatMap
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for flat_set and flat_map
+ */
+
+/*
+  ==========================
+  flat_set tests
+  ==========================
+*/
+
+//Tests flat_set<int> insert, find and erase in random order
+BOOST_AUTO_TEST_CASE(flat_set_int_insert_find_erase) {
+  boost::flat_set<int> s;
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK(s.insert((i * 37) % 100).second);
+  }
+  BOOST_CHECK(!s.insert(5).second);
+  BOOST_CHECK(s.size()==100);
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK(*(s.begin() + i)==i);
+    BOOST_CHECK(s.count(i)==1);
+  }
+  BOOST_CHECK(s.find(100)==s.end());
+  BOOST_CHECK(s.find(-1)==s.end());
+  BOOST_CHECK(*s.lower_bound(-1)==0);
+  BOOST_CHECK(s.lower_bound(100)==s.end());
+
+  for (int i=0; i<100; i+=2) {
+    BOOST_CHECK(s.erase(i)==1);
+  }
+  BOOST_CHECK(s.erase(0)==0);
+  BOOST_CHECK(s.size()==50);
+  for (int i=0; i<50; i++) {
+    BOOST_CHECK(*(s.begin() + i)==2*i+1);
+  }
+}
+
+//Tests flat_set<int> with front biased (decreasing) inserts
+BOOST_AUTO_TEST_CASE(flat_set_int_front_inserts) {
+  boost::flat_set<int, std::greater<int> > s;
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK(s.insert(i).second);
+  }
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK(*(s.begin() + i)==99-i);
+  }
+  BOOST_CHECK(s.find(42)!=s.end());
+}
+
+//Tests flat_set<int> insert_sorted merges and removes duplicates
+BOOST_AUTO_TEST_CASE(flat_set_int_insert_sorted) {
+  boost::flat_set<int> s;
+  s.insert(2);
+  s.insert(5);
+  s.insert(9);
+  int in[] = {1, 2, 2, 3, 9, 10};
+  s.insert_sorted(in, in + 6);
+  int expected[] = {1, 2, 3, 5, 9, 10};
+  BOOST_CHECK(s.size()==6);
+  for (int i=0; i<6; i++) {
+    BOOST_CHECK(*(s.begin() + i)==expected[i]);
+  }
+  s.clear();
+  BOOST_CHECK(s.empty());
+}
+
+//Tests flat_set<string> with keys longer than the small string buffer
+BOOST_AUTO_TEST_CASE(flat_set_string) {
+  boost::flat_set<std::string> s;
+  for (int i=0; i<200; i++) {
+    s.insert(std::string(i % 30, 'k') + std::to_string((i * 37) % 200));
+  }
+  BOOST_CHECK(s.size()==200);
+  for (boost::flat_set<std::string>::size_type i=1; i<s.size(); i++) {
+    BOOST_CHECK(*(s.begin() + i - 1) < *(s.begin() + i));
+  }
+  BOOST_CHECK(s.count(std::string(1, 'k') + std::to_string(37))==1);
+  BOOST_CHECK(s.erase(std::string(1, 'k') + std::to_string(37))==1);
+  BOOST_CHECK(s.size()==199);
+}
+
+/*
+  ==========================
+  flat_map tests
+  ==========================
+*/
+
+//Tests flat_map<int, double> insert, find and erase
+BOOST_AUTO_TEST_CASE(flat_map_int_double) {
+  boost::flat_map<int, double> m;
+  BOOST_CHECK(m.insert(3, 3.5));
+  BOOST_CHECK(m.insert(1, 1.5));
+  BOOST_CHECK(m.insert(2, 2.5));
+  BOOST_CHECK(!m.insert(2, 0.0));
+  BOOST_CHECK(m.size()==3);
+  BOOST_CHECK(*m.find(2)==2.5);
+  BOOST_CHECK(m.find(4)==NULL);
+  BOOST_CHECK(m.index_of(4)==m.npos);
+  BOOST_CHECK(m.key_at(0)==1 && m.value_at(0)==1.5);
+  BOOST_CHECK(m.keys()[2]==3 && m.values()[2]==3.5);
+
+  m[0] = 0.5;
+  m[2] += 1;
+  BOOST_CHECK(m.size()==4);
+  BOOST_CHECK(m.value_at(0)==0.5);
+  BOOST_CHECK(*m.find(2)==3.5);
+
+  BOOST_CHECK(m.erase(1)==1);
+  BOOST_CHECK(m.erase(1)==0);
+  BOOST_CHECK(m.size()==3);
+  BOOST_CHECK(m.key_at(1)==2 && m.value_at(1)==3.5);
+}
+
+//Tests flat_map<int, int> keeps keys and values paired through shifts on both sides
+BOOST_AUTO_TEST_CASE(flat_map_int_int_shifts) {
+  boost::flat_map<int, int> m;
+  for (int i=0; i<200; i++) {
+    int k = (i * 71) % 200;
+    m.insert(k, -k);
+  }
+  for (int i=0; i<200; i+=3) {
+    m.erase((i * 13) % 200);
+  }
+  for (boost::flat_map<int, int>::size_type i=0; i<m.size(); i++) {
+    BOOST_CHECK(m.value_at(i)==-m.key_at(i));
+    if (i > 0)
+      BOOST_CHECK(m.key_at(i-1) < m.key_at(i));
+  }
+}
+
+//Tests flat_map<int, int> insert_sorted keeps the existing values
+BOOST_AUTO_TEST_CASE(flat_map_int_insert_sorted) {
+  boost::flat_map<int, int> m;
+  m.insert(2, 20);
+  m.insert(4, 40);
+  std::vector<std::pair<int, int> > in;
+  in.push_back(std::make_pair(1, 10));
+  in.push_back(std::make_pair(2, 0));
+  in.push_back(std::make_pair(3, 30));
+  in.push_back(std::make_pair(3, 0));
+  in.push_back(std::make_pair(5, 50));
+  m.insert_sorted(in.begin(), in.end());
+  BOOST_CHECK(m.size()==5);
+  for (int i=1; i<=5; i++) {
+    BOOST_CHECK(m.key_at(i-1)==i);
+    BOOST_CHECK(m.value_at(i-1)==10*i);
+  }
+}
+
+//Tests flat_map<string, string>
+BOOST_AUTO_TEST_CASE(flat_map_string_string) {
+  boost::flat_map<std::string, std::string> m;
+  for (int i=0; i<100; i++) {
+    std::string k = std::to_string((i * 71) % 100);
+    m[k] = "a value that doesn't fit in the small string buffer " + k;
+  }
+  BOOST_CHECK(m.size()==100);
+  BOOST_CHECK(*m.find("42")=="a value that doesn't fit in the small string buffer 42");
+  BOOST_CHECK(m.erase("42")==1);
+  BOOST_CHECK(m.find("42")==NULL);
+  for (boost::flat_map<std::string, std::string>::size_type i=0; i<m.size(); i++) {
+    BOOST_CHECK(m.value_at(i)=="a value that doesn't fit in the small string buffer " + m.key_at(i));
+  }
+}
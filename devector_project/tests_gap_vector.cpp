@@ -0,0 +1,87 @@
+#include "gap_vector.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleGapVector
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for gap_vector
+ */
+
+//Tests gap_vector<int> edits around a moving cursor against std::vector
+BOOST_AUTO_TEST_CASE(gap_vector_int_editing) {
+  boost::gap_vector<int> g;
+  std::vector<int> expected;
+  size_t cursor = 0;
+  unsigned seed = 7;
+  for (int i=0; i<5000; i++) {
+    seed = seed * 1103515245 + 12345;
+    unsigned r = (seed >> 8) % 100;
+    if (r < 10) {
+      cursor = (seed >> 12) % (expected.size() + 1);
+      g.set_cursor(cursor);
+    } else if (r < 20 && cursor > 0) {
+      g.erase_before();
+      expected.erase(expected.begin() + --cursor);
+    } else if (r < 25 && cursor < expected.size()) {
+      g.erase_after();
+      expected.erase(expected.begin() + cursor);
+    } else {
+      g.insert(i);
+      expected.insert(expected.begin() + cursor++, i);
+    }
+  }
+  BOOST_CHECK(g.size()==expected.size());
+  BOOST_CHECK(g.cursor()==cursor);
+  BOOST_CHECK(g.before().size()==cursor && g.after().size()==expected.size() - cursor);
+  BOOST_CHECK(std::equal(g.before().begin(), g.before().end(), expected.begin()));
+  BOOST_CHECK(std::equal(g.after().begin(), g.after().end(), expected.begin() + cursor));
+  int wrong = 0;
+  for (size_t i=0; i<expected.size(); i++) {
+    wrong += (g[i] != expected[i]);
+  }
+  BOOST_CHECK(wrong==0);
+  BOOST_CHECK_THROW(g.at(expected.size()), boost::exceptions::out_of_bounds);
+  //moving the cursor to either end leaves the whole sequence contiguous
+  g.set_cursor(0);
+  BOOST_CHECK(g.before().empty() && std::equal(g.after().begin(), g.after().end(), expected.begin()));
+  g.set_cursor(g.size());
+  BOOST_CHECK(g.after().empty() && std::equal(g.before().begin(), g.before().end(), expected.begin()));
+  //inserting an element of the gap_vector itself while it grows
+  while (g.gap_size() > 0) {
+    g.insert(-1);
+  }
+  g.insert(g[0]);
+  BOOST_CHECK(g[g.size() - 1]==expected[0]);
+}
+
+//Tests gap_vector with strings and move only elements, range inserts and clear
+BOOST_AUTO_TEST_CASE(gap_vector_nontrivial) {
+  boost::gap_vector<std::string> g;
+  std::vector<std::string> words;
+  for (int i=0; i<200; i++) {
+    words.push_back(std::string(i % 30, 'w') + std::to_string(i));
+  }
+  g.insert(words.begin(), words.end());
+  g.set_cursor(100);
+  g.insert(std::string("middle"));
+  g.erase_after(50);
+  BOOST_CHECK(g.size()==151);
+  BOOST_CHECK(g[99]==words[99] && g[100]=="middle" && g[101]==words[150]);
+  std::string joined;
+  g.for_each([&](const std::string& s) { joined += s[s.size() - 1]; });
+  BOOST_CHECK(joined.size()==151);
+  g.clear();
+  BOOST_CHECK(g.empty() && g.gap_size()==g.capacity());
+
+  boost::gap_vector<std::unique_ptr<int> > owners;
+  for (int i=0; i<100; i++) {
+    owners.insert(std::unique_ptr<int>(new int(i)));
+    if (i % 10 == 0)
+      owners.set_cursor(owners.size() / 2);
+  }
+  int sum = 0;
+  owners.for_each([&](std::unique_ptr<int>& p) { sum += *p; });
+  BOOST_CHECK(sum==99 * 100 / 2);
+}
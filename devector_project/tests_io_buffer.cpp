@@ -0,0 +1,141 @@
+//The automatic shrink of devector is opt in, strip must not apply it when it's on
+#define VECTOR_SHRINK_DIV 4
+#include "io_buffer.hpp"
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleIoBuffer
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for io_buffer and io_chain
+ */
+
+//Tests that headers are prepended and stripped around the payload without moving it
+BOOST_AUTO_TEST_CASE(io_buffer_headroom) {
+  boost::io_buffer b(64, 1000);
+  BOOST_CHECK(b.empty());
+  BOOST_CHECK(b.headroom()>=64 && b.tailroom()>=1000);
+  const char payload[] = "GET / HTTP/1.1";
+  b.append(payload, sizeof(payload) - 1);
+  uint8_t* body = b.data();
+  memset(b.prepend(20).data(), 't', 20);
+  memset(b.prepend(20).data(), 'i', 20);
+  BOOST_CHECK(b.size()==20 + 20 + sizeof(payload) - 1);
+  BOOST_CHECK(b.data()==body - 40);
+  BOOST_CHECK(b[0]=='i' && b[19]=='i' && b[20]=='t' && b[39]=='t');
+  BOOST_CHECK(memcmp(b.data() + 40, payload, sizeof(payload) - 1)==0);
+  b.strip_front(20);
+  BOOST_CHECK(b.data()==body - 20 && b[0]=='t');
+  b.strip_front(20);
+  b.strip_back(9);
+  BOOST_CHECK(b.data()==body && b.size()==5 && memcmp(b.data(), "GET /", 5)==0);
+  //past the headroom, prepend grows the front and the bytes move once
+  for (int i=0; i<100; i++) {
+    b.prepend("0123456789", 10);
+  }
+  BOOST_CHECK(b.size()==1005);
+  BOOST_CHECK(memcmp(b.data(), "0123456789", 10)==0 && memcmp(b.data() + 1000, "GET /", 5)==0);
+  b.reserve_headroom(4096);
+  BOOST_CHECK(b.headroom()>=4096 && b.size()==1005);
+  boost::io_buffer moved(std::move(b));
+  BOOST_CHECK(moved.size()==1005 && b.empty());
+}
+
+//Tests that stripping a small read out of a big buffer only moves the ends of the live bytes
+BOOST_AUTO_TEST_CASE(io_buffer_strip_keeps_room) {
+  boost::io_buffer b(64, 65536);
+  iovec tail = b.tailroom_iovec();
+  memset(tail.iov_base, 'r', 1500);
+  b.commit(1500);
+  uint8_t* data = b.data();
+  boost::io_buffer::size_type headroom = b.headroom(), tailroom = b.tailroom();
+  b.strip_front(20);
+  BOOST_CHECK(b.data()==data + 20);
+  BOOST_CHECK(b.headroom()==headroom + 20 && b.tailroom()==tailroom);
+  b.strip_back(1000);
+  BOOST_CHECK(b.data()==data + 20 && b.size()==480);
+  BOOST_CHECK(b.headroom()==headroom + 20 && b.tailroom()==tailroom + 1000);
+  //the tailroom handed to readv before the strips is still the buffer's
+  BOOST_CHECK((uint8_t*)tail.iov_base==data && memcmp(b.data(), "rrrr", 4)==0);
+  b.strip_front(480);
+  BOOST_CHECK(b.empty() && b.headroom() + b.tailroom()==headroom + 1500 + tailroom);
+  //nor does a buffer that grew by appending, without any reserved room
+  boost::io_buffer grown;
+  for (int i=0; i<64; i++) {
+    memset(grown.append(1024).data(), 'g', 1024);
+  }
+  data = grown.data();
+  grown.strip_back(60 * 1024);
+  grown.strip_front(1000);
+  BOOST_CHECK(grown.data()==data + 1000 && grown.size()==4 * 1024 - 1000);
+}
+
+//Tests that a cleared buffer gets its reserved headroom back and can be refilled without reallocating
+BOOST_AUTO_TEST_CASE(io_buffer_clear_and_refill) {
+  boost::io_buffer b(64, 1500);
+  uint8_t* data = b.data();
+  boost::io_buffer::size_type headroom = b.headroom(), tailroom = b.tailroom();
+  BOOST_CHECK(headroom>=64 && tailroom>=1500);
+  for (int packet=0; packet<3; packet++) {
+    memset(b.append(1400).data(), 'p', 1400);
+    memset(b.prepend(40).data(), 'h', 40);
+    BOOST_CHECK(b.data()==data - 40 && b.size()==1440);
+    b.strip_front(20);
+    b.clear();
+    BOOST_CHECK(b.empty() && b.data()==data);
+    BOOST_CHECK(b.headroom()==headroom && b.tailroom()==tailroom);
+  }
+  //a headroom reserved later is kept too
+  b.reserve_headroom(4096);
+  b.clear();
+  BOOST_CHECK(b.headroom()>=4096);
+  data = b.data();
+  memset(b.append(1400).data(), 'p', 1400);
+  BOOST_CHECK(b.data()==data);
+}
+
+//Tests a gathering writev and a scattering readv through a socket pair
+BOOST_AUTO_TEST_CASE(io_chain_writev_readv) {
+  int fds[2];
+  BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds)==0);
+  boost::io_buffer header(0, 16), payload(32, 0);
+  header.append("HDR:", 4);
+  std::string text(3000, 'x');
+  text[0] = 'a';
+  text[2999] = 'z';
+  payload.append(text.data(), text.size());
+  boost::io_chain out;
+  out.append(payload);
+  out.prepend(header);
+  BOOST_CHECK(out.count()==2 && out.bytes()==3004);
+  ssize_t written = writev(fds[0], out.data(), out.count());
+  BOOST_CHECK(written==3004);
+  out.consume(written);
+  BOOST_CHECK(out.empty());
+
+  boost::io_buffer first(0, 4), rest(0, 5000);
+  boost::io_chain in;
+  in.append_tailroom(first);
+  in.append_tailroom(rest);
+  ssize_t got = 0;
+  while (got < 3004) {
+    ssize_t n = readv(fds[1], in.data(), in.count());
+    BOOST_REQUIRE(n > 0);
+    in.commit(n);
+    got += n;
+  }
+  BOOST_CHECK(first.size()==4 && memcmp(first.data(), "HDR:", 4)==0);
+  BOOST_CHECK(rest.size()==3000 && rest[0]=='a' && rest[2999]=='z');
+  close(fds[0]);
+  close(fds[1]);
+
+  //a partial write leaves the rest of the chain ready for the next writev
+  boost::io_chain partial;
+  partial.append(first);
+  partial.append(rest);
+  partial.consume(6);
+  BOOST_CHECK(partial.count()==1 && partial.bytes()==2998);
+  BOOST_CHECK(partial.data()[0].iov_base==rest.data() + 2);
+}
@@ -0,0 +1,80 @@
+#include "work_stealing_deque.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleWorkStealingDeque
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for work_stealing_deque
+ */
+
+//Tests the owner's LIFO end, the thieves' FIFO end and growth, on a single thread
+BOOST_AUTO_TEST_CASE(work_stealing_deque_single_thread) {
+  boost::work_stealing_deque<int> d(4);
+  int x = -1;
+  BOOST_CHECK(d.empty());
+  BOOST_CHECK(!d.pop(x));
+  BOOST_CHECK(!d.steal(x));
+  for (int i=0; i<100; i++) {
+    d.push(i);
+  }
+  BOOST_CHECK(d.size()==100);
+  BOOST_CHECK(d.capacity()==128);
+  BOOST_CHECK(d.pop(x) && x==99);
+  BOOST_CHECK(d.steal(x) && x==0);
+  BOOST_CHECK(d.steal(x) && x==1);
+  for (int i=98; i>=2; i--) {
+    BOOST_CHECK(d.pop(x) && x==i);
+  }
+  BOOST_CHECK(!d.pop(x));
+  BOOST_CHECK(!d.steal(x));
+  //the indices keep going after the deque was emptied
+  d.push(7);
+  BOOST_CHECK(d.steal(x) && x==7);
+  BOOST_CHECK(d.empty());
+}
+
+//Tests that every pushed element is taken exactly once, by the owner or by one of the thieves
+BOOST_AUTO_TEST_CASE(work_stealing_deque_concurrent) {
+  const int count = 200000;
+  const int thieves = 3;
+  boost::work_stealing_deque<int> d(2);
+  std::vector<std::atomic<int> > taken(count);
+  for (int i=0; i<count; i++) {
+    taken[i].store(0);
+  }
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (int t=0; t<thieves; t++) {
+    threads.push_back(std::thread([&]() {
+      int x;
+      while (!done.load()) {
+        if (d.steal(x))
+          taken[x].fetch_add(1);
+      }
+    }));
+  }
+  int x;
+  for (int i=0; i<count; i++) {
+    d.push(i);
+    if (i % 3 == 0 && d.pop(x))
+      taken[x].fetch_add(1);
+  }
+  while (d.pop(x)) {
+    taken[x].fetch_add(1);
+  }
+  done.store(true);
+  for (size_t t=0; t<threads.size(); t++) {
+    threads[t].join();
+  }
+  //pop can only fail on an empty deque or by losing the last element to a thief
+  while (d.steal(x)) {
+    taken[x].fetch_add(1);
+  }
+  int wrong = 0;
+  for (int i=0; i<count; i++) {
+    wrong += (taken[i].load() != 1);
+  }
+  BOOST_CHECK(wrong==0);
+}
@@ -0,0 +1,215 @@
+#ifndef BOOST_CONTAINER_CONTAINER_WORK_STEALING_DEQUE_HPP
+#define BOOST_CONTAINER_CONTAINER_WORK_STEALING_DEQUE_HPP
+
+/*
+  C++ work-stealing deque (Chase-Lev), for task schedulers
+
+  Each worker thread owns one deque. The owner pushes and pops at the bottom (LIFO, so it keeps working on the
+  hottest tasks), while any other thread can steal from the top (FIFO, so thieves take the oldest, usually biggest,
+  tasks). Only the owner may call push and pop; steal can be called from any thread.
+     + push and pop are wait-free and touch no shared cache line unless the deque is nearly empty
+     + steal is lock-free: a single CAS on top, which only fails if the owner or another thief took that element
+  The implementation follows "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen,
+  Zappa Nardelli, PPoPP 2013), which is the C++11 memory model version of the Chase-Lev algorithm.
+
+  Like devector, the elements live in a contiguous buffer between two indices (top and bottom) that can both move,
+  but here the buffer is circular: indices only grow and are taken modulo the capacity, a power of two.
+  When the owner pushes on a full buffer, it copies the live elements to a buffer twice as big and publishes it.
+  Thieves may still be reading the old buffer, so it can't be freed (or its elements destroyed) at that point: it is
+  retired to a list that is freed by the destructor. The retired buffers add up to less than the final one.
+
+  The elements are read by thieves while the owner may overwrite the same slot, so they are stored as std::atomic<T>
+  and T must be trivially copyable (typically a pointer to a task, or a small index).
+ */
+
+//Memory is used to include std::allocator
+#include <memory>
+//We include atomic for the indices, the published buffer and the slots
+#include <atomic>
+//We include type_traits for is_trivially_copyable
+#include <type_traits>
+
+namespace boost {
+  template <typename T, class Alloc = std::allocator<T> >
+  class work_stealing_deque {
+    static_assert(std::is_trivially_copyable<T>::value, "work_stealing_deque needs a trivially copyable value_type");
+  public:
+    //types:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef unsigned int size_type;
+
+  private:
+    struct ring {
+      long long capacity; //power of two
+      std::atomic<T>* slots;
+      ring* retired; //next retired buffer (only used by the owner)
+
+      T load(long long i) const {
+        return slots[i & (capacity - 1)].load(std::memory_order_relaxed);
+      }
+
+      void store(long long i, T x) {
+        slots[i & (capacity - 1)].store(x, std::memory_order_relaxed);
+      }
+    };
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<ring> ring_allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<std::atomic<T> > slot_allocator_type;
+
+  public:
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    explicit work_stealing_deque(size_type capacity = 64) : m_top(0), m_bottom(0), m_retired(NULL) {
+      long long n = 1;
+      while (n < (long long)capacity) {
+        n *= 2;
+      }
+      m_ring.store(priv_new_ring(n), std::memory_order_relaxed);
+    }
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    /*
+      Destructor. No other thread may be using the deque anymore
+     */
+    ~work_stealing_deque() noexcept {
+      priv_delete_ring(m_ring.load(std::memory_order_relaxed));
+      while (m_retired != NULL) {
+        ring* next = m_retired->retired;
+        priv_delete_ring(m_retired);
+        m_retired = next;
+      }
+    }
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    /*
+      Number of elements. Only exact when no other thread is using the deque
+     */
+    size_type size() const noexcept {
+      long long b = m_bottom.load(std::memory_order_relaxed);
+      long long t = m_top.load(std::memory_order_relaxed);
+      return (size_type)(b > t ? b - t : 0);
+    }
+
+    bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    size_type capacity() const noexcept {
+      return (size_type)m_ring.load(std::memory_order_relaxed)->capacity;
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Owner only. Pushes x at the bottom, growing the buffer if it's full
+     */
+    void push(const T& x) {
+      long long b = m_bottom.load(std::memory_order_relaxed);
+      long long t = m_top.load(std::memory_order_acquire);
+      ring* r = m_ring.load(std::memory_order_relaxed);
+      if (b - t > r->capacity - 1)
+        r = priv_grow(r, t, b);
+      r->store(b, x);
+      std::atomic_thread_fence(std::memory_order_release);
+      m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /*
+      Owner only. Pops the bottom element (the last pushed) into x. Returns false if the deque was empty
+     */
+    bool pop(T& x) {
+      long long b = m_bottom.load(std::memory_order_relaxed) - 1;
+      ring* r = m_ring.load(std::memory_order_relaxed);
+      m_bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      long long t = m_top.load(std::memory_order_relaxed);
+      if (t > b) {
+        m_bottom.store(b + 1, std::memory_order_relaxed); //it was empty
+        return false;
+      }
+      x = r->load(b);
+      if (t == b) {
+        //last element: race the thieves for it
+        bool won = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+      }
+      return true;
+    }
+
+    /*
+      Any thread. Steals the top element (the oldest) into x. Returns false if the deque was empty or if another
+      thread took that element first (the caller usually tries another victim)
+     */
+    bool steal(T& x) {
+      long long t = m_top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      long long b = m_bottom.load(std::memory_order_acquire);
+      if (t >= b)
+        return false;
+      ring* r = m_ring.load(std::memory_order_acquire); //consume in the paper
+      x = r->load(t);
+      return m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<long long> m_top; //index of the oldest element, only ever incremented (by CAS)
+    char m_padding[64 - sizeof(std::atomic<long long>)]; //keeps thieves' CAS on m_top off m_bottom's cache line
+    std::atomic<long long> m_bottom; //index past the newest element, only written by the owner
+    std::atomic<ring*> m_ring; //current buffer
+    ring* m_retired; //buffers replaced by a bigger one, that thieves might still be reading
+    ring_allocator_type m_ring_allocator;
+    slot_allocator_type m_slot_allocator;
+
+    ring* priv_new_ring(long long capacity) {
+      ring* r = m_ring_allocator.allocate(1);
+      try {
+        r->slots = m_slot_allocator.allocate((std::size_t)capacity);
+      } catch (...) {
+        m_ring_allocator.deallocate(r, 1);
+        throw;
+      }
+      for (long long i=0; i<capacity; i++) {
+        ::new ((void*)(r->slots + i)) std::atomic<T>();
+      }
+      r->capacity = capacity;
+      r->retired = NULL;
+      return r;
+    }
+
+    void priv_delete_ring(ring* r) noexcept {
+      m_slot_allocator.deallocate(r->slots, (std::size_t)r->capacity);
+      m_ring_allocator.deallocate(r, 1);
+    }
+
+    /*
+      Copies [t, b) to a buffer twice as big, publishes it and retires r. The elements are copied, not relocated,
+      as thieves may still read them from r
+     */
+    ring* priv_grow(ring* r, long long t, long long b) {
+      ring* bigger = priv_new_ring(r->capacity * 2);
+      for (long long i=t; i<b; i++) {
+        bigger->store(i, r->load(i));
+      }
+      m_ring.store(bigger, std::memory_order_release);
+      r->retired = m_retired;
+      m_retired = r;
+      return bigger;
+    }
+  };
+};
+
+
+#endif
@@ -0,0 +1,573 @@
+#ifndef BOOST_CONTAINER_CONTAINER_FLAT_HASH_MAP_HPP
+#define BOOST_CONTAINER_CONTAINER_FLAT_HASH_MAP_HPP
+
+/*
+  C++ open addressing hash map, in the style of Abseil's SwissTable
+
+  std::unordered_map allocates a node per element and chains them from the buckets, so every lookup follows at least
+  one pointer to a random cache line. flat_hash_map keeps the elements in a single contiguous array of slots and
+  resolves collisions by probing other slots of that array, with a separate array of one metadata byte per slot:
+     + empty (0x80), deleted (0xFE), or the 7 low bits of the element's hash (h2) if the slot is full
+  The slots are split in groups of 16. A lookup hashes the key once, uses the high bits (h1) to pick a group and
+  compares h2 against the 16 metadata bytes of the group at once (one SSE2 compare and movemask, or a portable loop
+  when SSE2 isn't available or BOOST_FLAT_HASH_NO_SIMD is defined). Only the slots whose byte matches are compared with
+  the key, so a lookup does on average little more than one key comparison, whether the key is present or not.
+  If the group has no empty byte the next group is probed (quadratic probing over the groups).
+
+     + erase leaves a deleted marker, unless the group still has an empty slot (then no probe can have gone past it)
+     + the table grows when it reaches GrowthPolicy::max_size(capacity) elements (deleted markers included). If
+       most of those are deleted markers it is rehashed at the same capacity instead.
+     + growth hashes every element into the new table first, and only then moves them with the relocation layer of
+       relocate.hpp (memcpy for trivially relocatable pairs), so a throwing Hash leaves the table as it was
+     + find and count accept any key type when both Hash and KeyEqual define is_transparent
+     + slots and metadata are allocated through Alloc (rebound), like boost::vector's buffer, so e.g.
+       aligned_allocator can be used
+
+  GrowthPolicy decides the maximum load and the growth factor:
+     struct policy {
+       static std::size_t max_size(std::size_t capacity); //elements a table of that capacity holds before growing
+       static std::size_t grow(std::size_t capacity);     //next capacity, a power of two bigger than capacity
+     };
+  hash_growth_policy<Num, Den> grows by 2 at a Num/Den maximum load (7/8 by default).
+
+  Iterators visit the elements in slot order, and are invalidated by any insertion that grows the table.
+  As in the other containers, const functions were mostly skipped.
+ */
+
+#include "vector.hpp"
+//We include functional for std::hash and std::equal_to
+#include <functional>
+//We include utility for std::pair and std::move_if_noexcept
+#include <utility>
+//We include tuple for std::forward_as_tuple
+#include <tuple>
+//We include cstdint for uint64_t
+#include <cstdint>
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(BOOST_FLAT_HASH_NO_SIMD)
+#define BOOST_FLAT_HASH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace boost {
+  template <unsigned Num = 7, unsigned Den = 8>
+  struct hash_growth_policy {
+    static_assert(Num < Den, "hash_growth_policy: the maximum load must be below 1");
+
+    static std::size_t max_size(std::size_t capacity) {
+      return capacity / Den * Num + capacity % Den * Num / Den;
+    }
+
+    static std::size_t grow(std::size_t capacity) {
+      return capacity * 2;
+    }
+  };
+
+  namespace detail {
+    typedef signed char hash_ctrl;
+    static const hash_ctrl hash_ctrl_empty = -128;
+    static const hash_ctrl hash_ctrl_deleted = -2;
+    static const unsigned hash_group_width = 16;
+
+    /*
+      The metadata bytes of one group, matched 16 at a time. The masks have bit i set for byte i
+     */
+    struct hash_group {
+#ifdef BOOST_FLAT_HASH_SSE2
+      __m128i ctrl;
+
+      explicit hash_group(const hash_ctrl* p) : ctrl(_mm_loadu_si128((const __m128i*)p)) {}
+
+      unsigned match(hash_ctrl h2) const {
+        return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+      }
+
+      unsigned match_empty() const {
+        return match(hash_ctrl_empty);
+      }
+
+      unsigned match_empty_or_deleted() const {
+        return (unsigned)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl));
+      }
+#else
+      const hash_ctrl* ctrl;
+
+      explicit hash_group(const hash_ctrl* p) : ctrl(p) {}
+
+      unsigned match(hash_ctrl h2) const {
+        unsigned mask = 0;
+        for (unsigned i=0; i<hash_group_width; i++) {
+          mask |= (unsigned)(ctrl[i] == h2) << i;
+        }
+        return mask;
+      }
+
+      unsigned match_empty() const {
+        return match(hash_ctrl_empty);
+      }
+
+      unsigned match_empty_or_deleted() const {
+        unsigned mask = 0;
+        for (unsigned i=0; i<hash_group_width; i++) {
+          mask |= (unsigned)(ctrl[i] < -1) << i;
+        }
+        return mask;
+      }
+#endif
+    };
+
+    inline unsigned lowest_bit(unsigned mask) {
+#if defined(__GNUC__)
+      return (unsigned)__builtin_ctz(mask);
+#else
+      unsigned i = 0;
+      while (!(mask & 1)) {
+        mask >>= 1;
+        i++;
+      }
+      return i;
+#endif
+    }
+
+    /*
+      Spreads the bits of the user's hash (std::hash of an integer is the identity), so that both h1 and h2 are usable
+     */
+    inline uint64_t mix_hash(std::size_t h) {
+      uint64_t x = (uint64_t)h * 0x9E3779B97F4A7C15ull;
+      return x ^ (x >> 32);
+    }
+  }
+
+  template <typename K, typename V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>,
+            class Alloc = std::allocator<std::pair<K, V> >, class GrowthPolicy = hash_growth_policy<> >
+  class flat_hash_map {
+  public:
+    //types:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef unsigned int size_type;
+
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<value_type> allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<detail::hash_ctrl> ctrl_allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<size_type> index_allocator_type;
+
+    class iterator {
+    public:
+      iterator() : m_ctrl(NULL), m_slot(NULL), m_end(NULL) {}
+
+      value_type& operator*() const {
+        return *m_slot;
+      }
+
+      value_type* operator->() const {
+        return m_slot;
+      }
+
+      iterator& operator++() {
+        ++m_ctrl; ++m_slot;
+        skip_free();
+        return *this;
+      }
+
+      bool operator==(const iterator& other) const {
+        return m_slot == other.m_slot;
+      }
+
+      bool operator!=(const iterator& other) const {
+        return m_slot != other.m_slot;
+      }
+
+    private:
+      friend class flat_hash_map;
+      const detail::hash_ctrl* m_ctrl;
+      value_type* m_slot;
+      const detail::hash_ctrl* m_end;
+
+      iterator(const detail::hash_ctrl* ctrl, value_type* slot, const detail::hash_ctrl* end) : m_ctrl(ctrl), m_slot(slot), m_end(end) {
+        skip_free();
+      }
+
+      void skip_free() {
+        while (m_ctrl != m_end && *m_ctrl < 0) {
+          ++m_ctrl; ++m_slot;
+        }
+      }
+    };
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    flat_hash_map() : m_ctrl(NULL), m_slots(NULL), m_capacity(0), m_size(0), m_growth_left(0) {}
+
+    explicit flat_hash_map(const Hash& hash, const KeyEqual& equal = KeyEqual())
+      : m_ctrl(NULL), m_slots(NULL), m_capacity(0), m_size(0), m_growth_left(0), m_hash(hash), m_equal(equal) {}
+
+    flat_hash_map(const flat_hash_map&) = delete;
+    flat_hash_map& operator=(const flat_hash_map&) = delete;
+
+    ~flat_hash_map() noexcept {
+      priv_destroy_all();
+      priv_deallocate(m_ctrl, m_slots, m_capacity);
+    }
+
+  /*
+  ========================================
+  Iterators
+  ========================================
+  */
+    iterator begin() noexcept {
+      return iterator(m_ctrl, m_slots, m_ctrl + m_capacity);
+    }
+
+    iterator end() noexcept {
+      return iterator(m_ctrl + m_capacity, m_slots + m_capacity, m_ctrl + m_capacity);
+    }
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_size;
+    }
+
+    bool empty() const noexcept {
+      return m_size == 0;
+    }
+
+    /*
+      Number of slots (a power of two, 0 before the first insertion)
+     */
+    size_type capacity() const noexcept {
+      return m_capacity;
+    }
+
+    float load_factor() const noexcept {
+      return m_capacity == 0 ? 0.0f : (float)m_size / m_capacity;
+    }
+
+    /*
+      Makes room for n elements, so that inserting up to n elements doesn't rehash
+     */
+    void reserve(size_type n) {
+      if (n <= m_size + m_growth_left)
+        return;
+      size_type capacity = (m_capacity == 0 ? detail::hash_group_width : m_capacity);
+      while (priv_max_size(capacity) < n) {
+        capacity = (size_type)GrowthPolicy::grow(capacity);
+      }
+      priv_rehash(capacity);
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    V& operator[](const K& key) {
+      return priv_find_or_insert(key)->second;
+    }
+
+    V& at(const K& key) {
+      V* v = find(key);
+      if (v == NULL)
+        throw exceptions::out_of_bounds();
+      return *v;
+    }
+
+  /*
+  ========================================
+  Lookup
+  ========================================
+  */
+    /*
+      Returns a pointer to the value of key, or NULL if it is not present
+     */
+    V* find(const K& key) {
+      value_type* slot = priv_find(key);
+      return slot == NULL ? NULL : &slot->second;
+    }
+
+    /*
+      Heterogeneous lookup (e.g. a const char* or a string view into a map of std::string), enabled when both
+      Hash and KeyEqual define is_transparent. Hash must hash q as it would hash the equal key.
+     */
+    template <class Q, class H = Hash, class E = KeyEqual, class = typename H::is_transparent, class = typename E::is_transparent>
+    V* find(const Q& q) {
+      value_type* slot = priv_find(q);
+      return slot == NULL ? NULL : &slot->second;
+    }
+
+    size_type count(const K& key) {
+      return priv_find(key) != NULL;
+    }
+
+    template <class Q, class H = Hash, class E = KeyEqual, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type count(const Q& q) {
+      return priv_find(q) != NULL;
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Inserts (key, value) if key isn't present. Returns whether it was inserted
+     */
+    bool insert(const K& key, const V& value) {
+      uint64_t h = detail::mix_hash(m_hash(key));
+      if (priv_find(key, h) != NULL)
+        return false;
+      size_type i = priv_prepare_insert(h);
+      m_allocator.construct(m_slots + i, key, value);
+      priv_commit_insert(i, h);
+      return true;
+    }
+
+    size_type erase(const K& key) {
+      value_type* slot = priv_find(key);
+      if (slot == NULL)
+        return 0;
+      size_type i = (size_type)(slot - m_slots);
+      m_allocator.destroy(slot);
+      //if the group still has an empty slot, no probe sequence can have continued past it
+      size_type group = i & ~(detail::hash_group_width - 1);
+      if (detail::hash_group(m_ctrl + group).match_empty() != 0) {
+        m_ctrl[i] = detail::hash_ctrl_empty;
+        m_growth_left++;
+      } else {
+        m_ctrl[i] = detail::hash_ctrl_deleted;
+      }
+      m_size--;
+      return 1;
+    }
+
+    /*
+      Destroys every element, keeping the capacity
+     */
+    void clear() noexcept {
+      priv_destroy_all();
+      for (size_type i=0; i<m_capacity; i++) {
+        m_ctrl[i] = detail::hash_ctrl_empty;
+      }
+      m_size = 0;
+      m_growth_left = priv_max_size(m_capacity);
+    }
+
+    void swap(flat_hash_map& other) noexcept {
+      std::swap(m_ctrl, other.m_ctrl);
+      std::swap(m_slots, other.m_slots);
+      std::swap(m_capacity, other.m_capacity);
+      std::swap(m_size, other.m_size);
+      std::swap(m_growth_left, other.m_growth_left);
+      std::swap(m_hash, other.m_hash);
+      std::swap(m_equal, other.m_equal);
+      std::swap(m_allocator, other.m_allocator);
+    }
+
+  private:
+    detail::hash_ctrl* m_ctrl; //one metadata byte per slot
+    value_type* m_slots; //m_capacity slots, constructed where m_ctrl is >= 0
+    size_type m_capacity; //number of slots, 0 or a power of two >= hash_group_width
+    size_type m_size; //number of elements
+    size_type m_growth_left; //empty slots that can still be filled before the table has to grow
+    Hash m_hash;
+    KeyEqual m_equal;
+    allocator_type m_allocator;
+
+    size_type priv_max_size(size_type capacity) const {
+      if (capacity == 0)
+        return 0;
+      size_type max = (size_type)GrowthPolicy::max_size(capacity);
+      return max < capacity ? max : capacity - 1; //there must always be an empty slot, so that probing stops
+    }
+
+    template <class Q>
+    value_type* priv_find(const Q& key) {
+      return priv_find(key, detail::mix_hash(m_hash(key)));
+    }
+
+    template <class Q>
+    value_type* priv_find(const Q& key, uint64_t h) {
+      if (m_capacity == 0)
+        return NULL;
+      detail::hash_ctrl h2 = (detail::hash_ctrl)(h & 0x7F);
+      size_type group_mask = m_capacity / detail::hash_group_width - 1;
+      size_type group = (size_type)(h >> 7) & group_mask;
+      for (size_type step = 1; ; step++) {
+        size_type base = group * detail::hash_group_width;
+        detail::hash_group g(m_ctrl + base);
+        for (unsigned mask = g.match(h2); mask != 0; mask &= mask - 1) {
+          size_type i = base + detail::lowest_bit(mask);
+          if (m_equal(m_slots[i].first, key))
+            return m_slots + i;
+        }
+        if (g.match_empty() != 0)
+          return NULL;
+        group = (group + step) & group_mask;
+      }
+    }
+
+    /*
+      First empty or deleted slot in the probe sequence of h
+     */
+    size_type priv_find_free(uint64_t h) const {
+      size_type group_mask = m_capacity / detail::hash_group_width - 1;
+      size_type group = (size_type)(h >> 7) & group_mask;
+      for (size_type step = 1; ; step++) {
+        size_type base = group * detail::hash_group_width;
+        unsigned mask = detail::hash_group(m_ctrl + base).match_empty_or_deleted();
+        if (mask != 0)
+          return base + detail::lowest_bit(mask);
+        group = (group + step) & group_mask;
+      }
+    }
+
+    /*
+      Returns the slot where an element with hash h (known not to be present) goes, rehashing first if needed
+     */
+    size_type priv_prepare_insert(uint64_t h) {
+      if (m_capacity != 0) {
+        size_type i = priv_find_free(h);
+        if (m_growth_left > 0 || m_ctrl[i] == detail::hash_ctrl_deleted)
+          return i;
+      }
+      if (m_capacity == 0) {
+        priv_rehash(detail::hash_group_width);
+      } else if (m_size < priv_max_size(m_capacity) / 2) {
+        priv_rehash(m_capacity); //mostly deleted markers: clean them up in place
+      } else {
+        priv_rehash((size_type)GrowthPolicy::grow(m_capacity));
+      }
+      return priv_find_free(h);
+    }
+
+    void priv_commit_insert(size_type i, uint64_t h) {
+      if (m_ctrl[i] == detail::hash_ctrl_empty)
+        m_growth_left--;
+      m_ctrl[i] = (detail::hash_ctrl)(h & 0x7F);
+      m_size++;
+    }
+
+    value_type* priv_find_or_insert(const K& key) {
+      uint64_t h = detail::mix_hash(m_hash(key));
+      value_type* slot = priv_find(key, h);
+      if (slot != NULL)
+        return slot;
+      size_type i = priv_prepare_insert(h);
+      m_allocator.construct(m_slots + i, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+      priv_commit_insert(i, h);
+      return m_slots + i;
+    }
+
+    /*
+      Moves every element to new arrays of the given capacity, in two passes: every element is hashed and given its new
+      slot first, and only then are they relocated, so a throwing hasher leaves the table untouched. Strong guarantee
+      (as relocate: the elements are only moved when that can't throw, otherwise they are copied, and the originals
+      destroyed once every copy succeeded)
+     */
+    void priv_rehash(size_type capacity) {
+      ctrl_allocator_type ctrl_allocator(m_allocator);
+      index_allocator_type index_allocator(m_allocator);
+      detail::hash_ctrl* old_ctrl = m_ctrl;
+      value_type* old_slots = m_slots;
+      size_type old_capacity = m_capacity;
+      value_type* new_slots = m_allocator.allocate(capacity);
+      size_type* targets = NULL; //new slot of every old slot (of the full ones)
+      try {
+        m_ctrl = ctrl_allocator.allocate(capacity);
+        try {
+          targets = index_allocator.allocate(old_capacity > 0 ? old_capacity : 1);
+        } catch (...) {
+          ctrl_allocator.deallocate(m_ctrl, capacity);
+          throw;
+        }
+      } catch (...) {
+        m_ctrl = old_ctrl;
+        m_allocator.deallocate(new_slots, capacity);
+        throw;
+      }
+      m_slots = new_slots;
+      m_capacity = capacity;
+      for (size_type i=0; i<capacity; i++) {
+        m_ctrl[i] = detail::hash_ctrl_empty;
+      }
+      try {
+        for (size_type i=0; i<old_capacity; i++) {
+          if (old_ctrl[i] >= 0) {
+            targets[i] = priv_find_free(detail::mix_hash(m_hash(old_slots[i].first)));
+            m_ctrl[targets[i]] = old_ctrl[i];
+          }
+        }
+        priv_relocate_to(old_ctrl, old_slots, old_capacity, targets, typename is_nothrow_relocatable<value_type>::type());
+      } catch (...) {
+        //the old slots still own every element, only the new arrays go
+        index_allocator.deallocate(targets, old_capacity > 0 ? old_capacity : 1);
+        priv_deallocate(m_ctrl, m_slots, m_capacity);
+        m_ctrl = old_ctrl;
+        m_slots = old_slots;
+        m_capacity = old_capacity;
+        throw;
+      }
+      index_allocator.deallocate(targets, old_capacity > 0 ? old_capacity : 1);
+      priv_deallocate(old_ctrl, old_slots, old_capacity);
+      m_growth_left = priv_max_size(m_capacity) - m_size;
+    }
+
+    /*
+      Second pass of priv_rehash: relocates every full old slot to its target in m_slots
+     */
+    void priv_relocate_to(detail::hash_ctrl* old_ctrl, value_type* old_slots, size_type old_capacity,
+                          const size_type* targets, std::true_type) noexcept {
+      for (size_type i=0; i<old_capacity; i++) {
+        if (old_ctrl[i] >= 0)
+          relocate(m_allocator, old_slots + i, old_slots + i + 1, m_slots + targets[i]);
+      }
+    }
+
+    void priv_relocate_to(detail::hash_ctrl* old_ctrl, value_type* old_slots, size_type old_capacity,
+                          const size_type* targets, std::false_type) {
+      size_type i = 0;
+      try {
+        for (; i<old_capacity; i++) {
+          if (old_ctrl[i] >= 0)
+            m_allocator.construct(m_slots + targets[i], std::move_if_noexcept(old_slots[i]));
+        }
+      } catch (...) {
+        for (size_type k=0; k<i; k++) {
+          if (old_ctrl[k] >= 0)
+            m_allocator.destroy(m_slots + targets[k]);
+        }
+        throw;
+      }
+      for (i=0; i<old_capacity; i++) {
+        if (old_ctrl[i] >= 0)
+          m_allocator.destroy(old_slots + i);
+      }
+    }
+
+    void priv_destroy_all() noexcept {
+      for (size_type i=0; i<m_capacity; i++) {
+        if (m_ctrl[i] >= 0)
+          m_allocator.destroy(m_slots + i);
+      }
+    }
+
+    void priv_deallocate(detail::hash_ctrl* ctrl, value_type* slots, size_type capacity) noexcept {
+      if (capacity == 0)
+        return;
+      ctrl_allocator_type ctrl_allocator(m_allocator);
+      ctrl_allocator.deallocate(ctrl, capacity);
+      m_allocator.deallocate(slots, capacity);
+    }
+  };
+};
+
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef BOOST_CONTAINER_CONTAINER_INCREMENTAL_VECTOR_HPP
+#define BOOST_CONTAINER_CONTAINER_INCREMENTAL_VECTOR_HPP
+
+/*
+  C++ vector with de-amortized (incremental) growth
+
+  boost::vector grows by copying the whole buffer inside a single call, so although push_back is O(1) amortized,
+  the push that triggers the growth is O(n). For latency sensitive code this shows up as rare but huge spikes.
+
+  incremental_vector grows as follows: when the buffer is full, a bigger buffer is allocated but the old one is kept.
+  Every following push_back then moves a bounded number of elements from the old buffer to the new one.
+  The number of elements moved per push is chosen at growth time so that the migration is over before the new buffer
+  fills up, so every push_back does O(1) work in the worst case, not just amortized.
+
+  While a migration is in progress elements live in two buffers (X = element in the new buffer, O = element still in
+  the old buffer, _ = allocated empty space):
+     old: [__OOOO]
+     new: [XX____XXX___]
+  so element access has to check which buffer holds the element. data(), begin() and end() need a single contiguous
+  array, so they finish the pending migration first (which is O(n) once per growth, like boost::vector).
+
+  As in vector.hpp, the growth constants are VECTOR_AMORT_INC and VECTOR_AMORT_MULT (which must be > 1 here).
+ */
+
+#include "vector.hpp"
+//We include utility for std::move
+#include <utility>
+
+namespace boost {
+  template <typename T, class Alloc = std::allocator<T> >
+  class incremental_vector {
+  public:
+    //types:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef value_type& reference;
+    typedef T* iterator;
+    typedef unsigned int size_type;
+    typedef size_type difference_type;
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+
+    incremental_vector() : m_size(0), m_capacity(0), m_buffer(NULL),
+                           m_old(NULL), m_old_capacity(0), m_old_size(0), m_moved(0), m_step(0) {}
+
+    incremental_vector(const size_type n) : m_size(0), m_capacity(0), m_buffer(NULL),
+                                            m_old(NULL), m_old_capacity(0), m_old_size(0), m_moved(0), m_step(0) {
+      if (n > 0) {
+        m_buffer = m_allocator.allocate(n);
+        m_capacity = n;
+      }
+    }
+
+    /*
+      Destructor
+     */
+    ~incremental_vector() noexcept {
+      for (size_type i=0; i<m_size; i++) {
+        m_allocator.destroy(priv_address(i));
+      }
+      if (m_old != NULL)
+        m_allocator.deallocate(m_old, m_old_capacity);
+      if (m_buffer != NULL)
+        m_allocator.deallocate(m_buffer, m_capacity);
+    }
+
+  /*
+  ========================================
+  Iterators
+  ========================================
+  */
+    iterator begin() {
+      return data();
+    }
+
+    iterator end() {
+      return data() + m_size;
+    }
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+
+    size_type size() const noexcept {
+      return m_size;
+    }
+
+    size_type capacity() const noexcept {
+      return m_capacity;
+    }
+
+    bool empty() const noexcept {
+      return (m_size == 0);
+    }
+
+    /*
+      Returns whether a growth is still being migrated
+     */
+    bool migrating() const noexcept {
+      return m_old != NULL;
+    }
+
+    /*
+      Explicit reserve is not incremental: it finishes any pending migration and then moves every element at once
+     */
+    void reserve(size_type n) {
+      if (n > m_capacity) {
+        priv_finish_migration();
+        value_type * pre_buffer = m_allocator.allocate(n);
+        try {
+          relocate(m_allocator, m_buffer, m_buffer + m_size, pre_buffer);
+        } catch (...) {
+          m_allocator.deallocate(pre_buffer, n);
+          throw;
+        }
+        if (m_buffer != NULL)
+          m_allocator.deallocate(m_buffer, m_capacity);
+        m_buffer = pre_buffer;
+        m_capacity = n;
+      }
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    reference operator[](size_type n) {
+      return at(n);
+    }
+
+    reference at(size_type n) {
+      if (n >= m_size)
+        throw exceptions::out_of_bounds();
+      return *priv_address(n);
+    }
+
+    reference front() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      return *priv_address(0);
+    }
+
+    reference back() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      return *priv_address(m_size - 1);
+    }
+
+    value_type* data() {
+      priv_finish_migration();
+      return m_buffer;
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Worst case O(m_step) = O(1): at most one allocation and m_step element moves
+     */
+    void push_back(const T& x) {
+      if (m_size >= m_capacity)
+        priv_grow();
+      m_allocator.construct(m_buffer + m_size, x);
+      m_size++;
+      if (m_old != NULL)
+        priv_migrate(m_step);
+    }
+
+    void push_back(T&& x) {
+      if (m_size >= m_capacity)
+        priv_grow();
+      m_allocator.construct(m_buffer + m_size, std::move(x));
+      m_size++;
+      if (m_old != NULL)
+        priv_migrate(m_step);
+    }
+
+    void pop_back() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      m_size--;
+      if (m_old != NULL && m_size < m_old_size) {
+        //the last element is still in the old buffer, so it was never moved
+        m_allocator.destroy(m_old + m_size);
+        m_old_size--;
+        if (m_moved == m_old_size)
+          priv_release_old();
+      } else {
+        m_allocator.destroy(m_buffer + m_size);
+      }
+    }
+
+    void clear() {
+      while (!empty()) {
+        pop_back();
+      }
+    }
+
+  private:
+    size_type m_size; //number of elements in the vector
+    size_type m_capacity; //number of allocated elements in m_buffer
+    Alloc m_allocator; //allocator class
+    T* m_buffer; //array of elements, holds [0, m_moved) and [m_old_size, m_size)
+
+    T* m_old; //buffer being migrated (NULL when there is none), holds [m_moved, m_old_size)
+    size_type m_old_capacity; //number of allocated elements in m_old
+    size_type m_old_size; //number of elements m_old had when the growth started (minus those popped since)
+    size_type m_moved; //number of elements already moved to m_buffer
+    size_type m_step; //number of elements moved on each push_back
+
+    T* priv_address(size_type n) {
+      if (m_old != NULL && n >= m_moved && n < m_old_size)
+        return m_old + n;
+      return m_buffer + n;
+    }
+
+    /*
+      Allocates the bigger buffer and starts the migration. Elements are only moved by the following push_backs.
+     */
+    void priv_grow() {
+      size_type n = (m_capacity + VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT);
+      if (n <= m_capacity)
+        n = m_capacity + 1;
+      priv_finish_migration(); //only happens if VECTOR_AMORT_MULT is too small to keep up
+      value_type * pre_buffer = m_allocator.allocate(n); //Throws if allocate throws
+      if (m_size == 0) {
+        if (m_buffer != NULL)
+          m_allocator.deallocate(m_buffer, m_capacity);
+      } else {
+        m_old = m_buffer;
+        m_old_capacity = m_capacity;
+        m_old_size = m_size;
+        m_moved = 0;
+        //n - m_size pushes fit in the new buffer, and all m_size elements have to be moved by then
+        m_step = (m_size + (n - m_size) - 1) / (n - m_size);
+      }
+      m_buffer = pre_buffer;
+      m_capacity = n;
+    }
+
+    void priv_migrate(size_type count) {
+      size_type last = m_moved + count;
+      if (last > m_old_size)
+        last = m_old_size;
+      relocate(m_allocator, m_old + m_moved, m_old + last, m_buffer + m_moved);
+      m_moved = last;
+      if (m_moved == m_old_size)
+        priv_release_old();
+    }
+
+    void priv_finish_migration() {
+      if (m_old != NULL)
+        priv_migrate(m_old_size - m_moved);
+    }
+
+    void priv_release_old() {
+      m_allocator.deallocate(m_old, m_old_capacity);
+      m_old = NULL;
+      m_old_capacity = 0;
+      m_old_size = 0;
+      m_moved = 0;
+    }
+  };
+};
+
+
+#endif
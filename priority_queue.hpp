@@ -0,0 +1,443 @@
+#ifndef BOOST_CONTAINER_CONTAINER_PRIORITY_QUEUE_HPP
+#define BOOST_CONTAINER_CONTAINER_PRIORITY_QUEUE_HPP
+
+/*
+  C++ priority queue adapters over boost::vector, implemented as d-ary heaps
+
+  std::priority_queue is a binary heap: every level of a sift down is a jump to a new cache line, and there are
+  log2(n) levels. With D children per node the heap is only log_D(n) levels deep, and the D children of a node are
+  compared in a single cache line. To make sure they do share a cache line, the heap is stored with D-1 padding
+  elements in front of it: the children of node i are then the physical elements [D*(i+1), D*(i+1)+D), which
+  start at a multiple of D. With D * sizeof(T) == 64 (e.g. D=16 for int, D=8 for pointers, D=4 for 16 byte
+  entries) and a 64 byte aligned buffer (Alloc = aligned_allocator<T>), every group of siblings is exactly one
+  cache line.
+
+     + push and pop are O(log_D(n)) (pop does D-1 comparisons per level)
+     + push_range appends the range and, if it is at least as big as the heap, rebuilds the heap bottom up in O(n)
+     + pop_push and replace_top replace the top element with a single sift down, instead of a pop and a push
+
+  Like std::priority_queue, the top is the greatest element according to Compare (std::less gives a max-heap).
+  T must be default constructible, for the padding elements.
+
+  indexed_priority_queue stores (id, key) pairs for ids in [0, n) and keeps the position of every id in the heap,
+  so that the key of an element that is already queued can be changed (decrease_key, as Dijkstra or A* need).
+ */
+
+#include "vector.hpp"
+//We include functional for std::less and std::greater
+#include <functional>
+//We include utility for std::move
+#include <utility>
+//We include iterator for std::distance
+#include <iterator>
+
+namespace boost {
+  template <typename T, class Compare = std::less<T>, unsigned D = 4, class Alloc = std::allocator<T> >
+  class priority_queue {
+  public:
+    //types:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef boost::vector<T, Alloc> container_type;
+    typedef const value_type& const_reference;
+    typedef typename container_type::size_type size_type;
+
+    static const unsigned arity = D;
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    priority_queue() {
+      priv_init();
+    }
+
+    explicit priority_queue(const Compare& comp) : m_compare(comp) {
+      priv_init();
+    }
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_c.size() - (D - 1);
+    }
+
+    bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    void reserve(size_type n) {
+      m_c.reserve(n + (D - 1));
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    const_reference top() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      return priv_heap()[0];
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    void push(const T& x) {
+      m_c.pre_push_back();
+      m_c.push_back(x);
+      priv_sift_up(size() - 1);
+    }
+
+    /*
+      Pushes every element of [first, last). Takes O(size() + distance(first, last)) when the range is at least
+      as big as the heap (bottom up heap construction), and O(distance(first, last) * log_D(size())) otherwise.
+     */
+    template <class ForwardIt>
+    void push_range(ForwardIt first, ForwardIt last) {
+      size_type old_size = size();
+      size_type count = std::distance(first, last);
+      for (; first != last; ++first) {
+        m_c.pre_push_back(); //geometric growth, as push: many small ranges don't reallocate on every call
+        m_c.push_back(*first);
+      }
+      if (count >= old_size) {
+        priv_make_heap();
+      } else {
+        for (size_type i=old_size; i<size(); i++) {
+          priv_sift_up(i);
+        }
+      }
+    }
+
+    void pop() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      size_type n = size();
+      if (n > 1) {
+        T last = std::move(priv_heap()[n - 1]);
+        m_c.pop_back();
+        priv_sift_down(0, std::move(last));
+      } else {
+        m_c.pop_back();
+      }
+    }
+
+    /*
+      Replaces the top by x. Same as pop() followed by push(x), but with a single sift down
+     */
+    void replace_top(const T& x) {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      priv_sift_down(0, x);
+    }
+
+    /*
+      Pops the top, pushes x and returns the popped element
+     */
+    T pop_push(const T& x) {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      T top = std::move(priv_heap()[0]);
+      priv_sift_down(0, x);
+      return top;
+    }
+
+    void clear() {
+      while (m_c.size() > D - 1) {
+        m_c.pop_back();
+      }
+    }
+
+  private:
+    container_type m_c; //D-1 padding elements followed by the heap
+    Compare m_compare; //the top is the greatest element according to m_compare
+
+    void priv_init() {
+      m_c.reserve(D - 1 + 1);
+      for (unsigned i=0; i<D-1; i++) {
+        m_c.push_back(T());
+      }
+    }
+
+    T* priv_heap() {
+      return m_c.data() + (D - 1);
+    }
+
+    void priv_sift_up(size_type i) {
+      T* h = priv_heap();
+      T x = std::move(h[i]);
+      while (i > 0) {
+        size_type parent = (i - 1) / D;
+        if (!m_compare(h[parent], x))
+          break;
+        h[i] = std::move(h[parent]);
+        i = parent;
+      }
+      h[i] = std::move(x);
+    }
+
+    /*
+      Moves the hole at i down until x can be placed in it
+     */
+    void priv_sift_down(size_type i, T x) {
+      T* h = priv_heap();
+      size_type n = size();
+      while (true) {
+        size_type child = D * i + 1;
+        if (child >= n)
+          break;
+        size_type last = (child + D < n ? child + D : n);
+        size_type best = child;
+        for (size_type j=child+1; j<last; j++) {
+          if (m_compare(h[best], h[j]))
+            best = j;
+        }
+        if (!m_compare(x, h[best]))
+          break;
+        h[i] = std::move(h[best]);
+        i = best;
+      }
+      h[i] = std::move(x);
+    }
+
+    void priv_make_heap() {
+      size_type n = size();
+      if (n < 2)
+        return;
+      T* h = priv_heap();
+      for (size_type i=(n - 2) / D + 1; i-- > 0; ) {
+        priv_sift_down(i, std::move(h[i]));
+      }
+    }
+  };
+
+  template <typename T, class Compare, unsigned D, class Alloc>
+  const unsigned priority_queue<T, Compare, D, Alloc>::arity;
+
+
+  template <typename Key, class Compare = std::greater<Key>, unsigned D = 4, class Alloc = std::allocator<Key> >
+  class indexed_priority_queue {
+  public:
+    //types:
+    typedef Key key_type;
+    typedef Compare key_compare;
+    typedef unsigned int size_type;
+    typedef size_type id_type;
+
+    struct entry {
+      Key key;
+      id_type id;
+    };
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    indexed_priority_queue() {
+      priv_init();
+    }
+
+    explicit indexed_priority_queue(const Compare& comp) : m_compare(comp) {
+      priv_init();
+    }
+
+  /*
+  ========================================
+  Capacity
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_heap.size() - (D - 1);
+    }
+
+    bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    /*
+      Reserves room for n queued elements with ids in [0, ids)
+     */
+    void reserve(size_type n, size_type ids) {
+      m_heap.reserve(n + (D - 1));
+      priv_reserve_ids(ids);
+    }
+
+  /*
+  ========================================
+  Element Access
+  ========================================
+  */
+    bool contains(id_type id) {
+      return id < m_position.size() && m_position[id] != 0;
+    }
+
+    const Key& key(id_type id) {
+      if (!contains(id))
+        throw exceptions::out_of_bounds();
+      return priv_heap()[m_position[id] - 1].key;
+    }
+
+    id_type top_id() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      return priv_heap()[0].id;
+    }
+
+    const Key& top_key() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      return priv_heap()[0].key;
+    }
+
+  /*
+  ========================================
+  Modifiers
+  ========================================
+  */
+    /*
+      Queues id with the given key, or changes its key if id is already queued
+     */
+    void push(id_type id, const Key& k) {
+      if (contains(id)) {
+        update(id, k);
+        return;
+      }
+      priv_reserve_ids(id + 1);
+      entry e;
+      e.key = k;
+      e.id = id;
+      m_heap.pre_push_back();
+      m_heap.push_back(e);
+      m_position[id] = size();
+      priv_sift_up(size() - 1);
+    }
+
+    void pop() {
+      if (empty())
+        throw exceptions::out_of_bounds();
+      priv_erase_at(0);
+    }
+
+    void erase(id_type id) {
+      if (contains(id))
+        priv_erase_at(m_position[id] - 1);
+    }
+
+    /*
+      Moves id towards the top: k must not compare below its current key (with the default std::greater, it
+      must not be bigger). O(log_D(size()))
+     */
+    void decrease_key(id_type id, const Key& k) {
+      if (!contains(id))
+        throw exceptions::out_of_bounds();
+      size_type i = m_position[id] - 1;
+      priv_heap()[i].key = k;
+      priv_sift_up(i);
+    }
+
+    /*
+      Changes the key of id in either direction
+     */
+    void update(id_type id, const Key& k) {
+      if (!contains(id))
+        throw exceptions::out_of_bounds();
+      size_type i = m_position[id] - 1;
+      entry* h = priv_heap();
+      bool up = m_compare(h[i].key, k);
+      h[i].key = k;
+      if (up)
+        priv_sift_up(i);
+      else
+        priv_sift_down(i, h[i]);
+    }
+
+  private:
+    boost::vector<entry, typename std::allocator_traits<Alloc>::template rebind_alloc<entry> > m_heap; //D-1 padding entries followed by the heap
+    boost::vector<size_type, typename std::allocator_traits<Alloc>::template rebind_alloc<size_type> > m_position; //heap position + 1 of every id, 0 if it isn't queued
+    Compare m_compare; //the top is the greatest key according to m_compare
+
+    void priv_init() {
+      m_heap.reserve(D - 1 + 1);
+      for (unsigned i=0; i<D-1; i++) {
+        m_heap.push_back(entry());
+      }
+    }
+
+    entry* priv_heap() {
+      return m_heap.data() + (D - 1);
+    }
+
+    void priv_reserve_ids(size_type ids) {
+      if (ids > m_position.size())
+        m_position.resize(ids > 2 * m_position.size() ? ids : 2 * m_position.size()); //new positions are 0
+    }
+
+    void priv_place(entry* h, size_type i, const entry& e) {
+      h[i] = e;
+      m_position[e.id] = i + 1;
+    }
+
+    void priv_sift_up(size_type i) {
+      entry* h = priv_heap();
+      entry x = h[i];
+      while (i > 0) {
+        size_type parent = (i - 1) / D;
+        if (!m_compare(h[parent].key, x.key))
+          break;
+        priv_place(h, i, h[parent]);
+        i = parent;
+      }
+      priv_place(h, i, x);
+    }
+
+    void priv_sift_down(size_type i, entry x) {
+      entry* h = priv_heap();
+      size_type n = size();
+      while (true) {
+        size_type child = D * i + 1;
+        if (child >= n)
+          break;
+        size_type last = (child + D < n ? child + D : n);
+        size_type best = child;
+        for (size_type j=child+1; j<last; j++) {
+          if (m_compare(h[best].key, h[j].key))
+            best = j;
+        }
+        if (!m_compare(x.key, h[best].key))
+          break;
+        priv_place(h, i, h[best]);
+        i = best;
+      }
+      priv_place(h, i, x);
+    }
+
+    void priv_erase_at(size_type i) {
+      entry* h = priv_heap();
+      size_type n = size();
+      m_position[h[i].id] = 0;
+      entry last = h[n - 1];
+      m_heap.pop_back();
+      if (i == n - 1)
+        return;
+      h = priv_heap();
+      if (i > 0 && m_compare(h[(i - 1) / D].key, last.key)) {
+        priv_place(h, i, last);
+        priv_sift_up(i);
+      } else {
+        priv_sift_down(i, last);
+      }
+    }
+  };
+};
+
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef BOOST_CONTAINER_CONTAINER_RECYCLING_ALLOCATOR_HPP
+#define BOOST_CONTAINER_CONTAINER_RECYCLING_ALLOCATOR_HPP
+
+/*
+  Allocator that recycles the buffers released on a thread for the next container of that thread
+
+  Scratch containers that are filled and destroyed once per batch (or request, or frame) go through the same
+  sequence of allocations every time: 1, 2, 4, ... elements until they reach the batch size. recycling_allocator
+  keeps the buffers that are released in a thread_local cache instead of freeing them, so from the second batch on
+  every one of those allocations is a pop from a free list, without calling operator new at all.
+
+  The cache is organized in power of two size classes: a request of n * sizeof(T) bytes is rounded up to the next
+  power of two (at least 64 bytes) and served from that class, so buffers are shared by any T and any container
+  using the allocator on the same thread. Released buffers are linked through their first bytes, nothing is
+  allocated to keep them.
+
+  Two constants bound what a thread keeps:
+     RECYCLING_CACHE_MAX_BYTES: requests bigger than this go straight to operator new and delete
+     RECYCLING_CACHE_PER_CLASS: at most this many buffers are kept per size class, the rest are freed
+  so a thread never holds more than about 2 * MAX_BYTES * PER_CLASS bytes. recycling_cache::local().trim() frees
+  them all earlier. A buffer may be released on a different thread than the one that allocated it, it simply goes
+  to that thread's cache. The cache frees its buffers when its thread exits; containers destroyed after that on the
+  same thread (thread_local or static ones destroyed after it) go straight to operator new and delete, see closed().
+ */
+
+//We include memory for std::allocator
+#include <memory>
+//We include new for operator new and delete
+#include <new>
+//We include utility for std::forward
+#include <utility>
+//We include release_pages for can_release_pages
+#include "release_pages.hpp"
+
+#ifndef RECYCLING_CACHE_MAX_BYTES
+#define RECYCLING_CACHE_MAX_BYTES (1 << 22)
+#endif
+#ifndef RECYCLING_CACHE_PER_CLASS
+#define RECYCLING_CACHE_PER_CLASS 4
+#endif
+
+namespace boost {
+  class recycling_cache {
+  public:
+    static const unsigned MIN_SHIFT = 6; //64 bytes, also enough room for the link
+    static const unsigned CLASSES = 64;
+
+    /*
+      The cache of the calling thread. Must not be called once closed() is true
+     */
+    static recycling_cache& local() noexcept {
+      static thread_local recycling_cache cache;
+      return cache;
+    }
+
+    /*
+      Whether the cache of the calling thread was already destroyed. The flag lives outside the cache, in a trivially
+      destructible thread_local, so it can still be read after that
+     */
+    static bool closed() noexcept {
+      return closed_flag();
+    }
+
+    /*
+      Size class of a request of the given bytes (which must not exceed RECYCLING_CACHE_MAX_BYTES)
+     */
+    static unsigned size_class(std::size_t bytes) noexcept {
+      if (bytes <= ((std::size_t)1 << MIN_SHIFT))
+        return MIN_SHIFT;
+#if defined(__GNUC__)
+      return 64 - __builtin_clzll((unsigned long long)(bytes - 1));
+#else
+      unsigned shift = MIN_SHIFT + 1;
+      while (((std::size_t)1 << shift) < bytes) {
+        shift++;
+      }
+      return shift;
+#endif
+    }
+
+    void* allocate(std::size_t bytes) {
+      if (bytes > RECYCLING_CACHE_MAX_BYTES)
+        return ::operator new(bytes);
+      unsigned c = size_class(bytes);
+      node* p = m_free[c];
+      if (p != NULL) {
+        m_free[c] = p->next;
+        m_count[c]--;
+        m_hits++;
+        return p;
+      }
+      m_misses++;
+      return ::operator new((std::size_t)1 << c);
+    }
+
+    void deallocate(void* p, std::size_t bytes) noexcept {
+      if (bytes > RECYCLING_CACHE_MAX_BYTES) {
+        ::operator delete(p);
+        return;
+      }
+      unsigned c = size_class(bytes);
+      if (m_count[c] >= RECYCLING_CACHE_PER_CLASS) {
+        ::operator delete(p);
+        return;
+      }
+      node* n = static_cast<node*>(p);
+      n->next = m_free[c];
+      m_free[c] = n;
+      m_count[c]++;
+    }
+
+    /*
+      Frees every cached buffer
+     */
+    void trim() noexcept {
+      for (unsigned c=0; c<CLASSES; c++) {
+        while (m_free[c] != NULL) {
+          node* p = m_free[c];
+          m_free[c] = p->next;
+          ::operator delete(p);
+        }
+        m_count[c] = 0;
+      }
+    }
+
+    //allocations served from the cache, and the ones that had to call operator new
+    unsigned long long hits() const noexcept {
+      return m_hits;
+    }
+
+    unsigned long long misses() const noexcept {
+      return m_misses;
+    }
+
+    std::size_t cached_bytes() const noexcept {
+      std::size_t total = 0;
+      for (unsigned c=0; c<CLASSES; c++) {
+        total += m_count[c] * ((std::size_t)1 << c);
+      }
+      return total;
+    }
+
+    ~recycling_cache() noexcept {
+      trim();
+      closed_flag() = true;
+    }
+
+  private:
+    struct node {
+      node* next;
+    };
+
+    node* m_free[CLASSES]; //free list of every size class
+    unsigned m_count[CLASSES]; //length of every free list
+    unsigned long long m_hits;
+    unsigned long long m_misses;
+
+    static bool& closed_flag() noexcept {
+      static thread_local bool closed = false;
+      return closed;
+    }
+
+    recycling_cache() noexcept : m_hits(0), m_misses(0) {
+      for (unsigned c=0; c<CLASSES; c++) {
+        m_free[c] = NULL;
+        m_count[c] = 0;
+      }
+    }
+
+    recycling_cache(const recycling_cache&) = delete;
+    recycling_cache& operator=(const recycling_cache&) = delete;
+  };
+
+  template <typename T>
+  class recycling_allocator {
+  public:
+    //types:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind {
+      typedef recycling_allocator<U> other;
+    };
+
+    recycling_allocator() noexcept {}
+
+    template <typename U>
+    recycling_allocator(const recycling_allocator<U>&) noexcept {}
+
+    /*
+      Returns NULL for n == 0, as there is nothing to recycle. Once the cache of the thread is gone, both go straight
+      to operator new and delete
+     */
+    T* allocate(size_type n) {
+      if (n == 0)
+        return NULL;
+      if (n > (size_type)-1 / sizeof(T))
+        throw std::bad_alloc();
+      if (recycling_cache::closed())
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+      return static_cast<T*>(recycling_cache::local().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_type n) noexcept {
+      if (p == NULL)
+        return;
+      if (recycling_cache::closed())
+        ::operator delete(p);
+      else
+        recycling_cache::local().deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+      ::new ((void*)p) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    void destroy(U* p) {
+      p->~U();
+    }
+  };
+
+  template <typename T, typename U>
+  bool operator==(const recycling_allocator<T>&, const recycling_allocator<U>&) noexcept {
+    return true;
+  }
+
+  template <typename T, typename U>
+  bool operator!=(const recycling_allocator<T>&, const recycling_allocator<U>&) noexcept {
+    return false;
+  }
+
+  //operator new memory is malloc memory, so unused pages can be released too (they come back zero filled)
+  template <typename T>
+  struct can_release_pages<recycling_allocator<T> > : std::true_type {};
+};
+
+
+#endif
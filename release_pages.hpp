@@ -0,0 +1,63 @@
+#ifndef BOOST_CONTAINER_CONTAINER_RELEASE_PAGES_HPP
+#define BOOST_CONTAINER_CONTAINER_RELEASE_PAGES_HPP
+
+/*
+  Returns unused parts of a buffer to the operating system without reallocating it.
+
+  release_pages(first, last) tells the kernel that the whole pages inside [first, last) are no longer needed.
+  The pages stay mapped, so the buffer and its capacity are untouched, but they stop counting towards the RSS
+  until they are written to again (they then come back zero filled). On systems without madvise it does nothing.
+
+  This is only valid for memory that comes from private anonymous mappings (malloc, operator new), so containers
+  only do it when can_release_pages<Alloc> holds, which by default is only the case for std::allocator.
+ */
+
+//We include memory for std::allocator
+#include <memory>
+//We include type_traits for std::true_type
+#include <type_traits>
+//We include cstdint for uintptr_t
+#include <cstdint>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace boost {
+  template <class Alloc>
+  struct can_release_pages : std::false_type {};
+
+  template <typename T>
+  struct can_release_pages<std::allocator<T> > : std::true_type {};
+
+  namespace detail {
+    inline uintptr_t page_size() {
+#if defined(_SC_PAGESIZE)
+      static const uintptr_t size = (uintptr_t)sysconf(_SC_PAGESIZE);
+      return size;
+#else
+      return 4096;
+#endif
+    }
+
+    /*
+      Returns the number of bytes released (0 if [first, last) holds no whole page)
+     */
+    inline uintptr_t release_pages(void * first, void * last) noexcept {
+#if defined(MADV_DONTNEED)
+      uintptr_t page = page_size();
+      uintptr_t begin = ((uintptr_t)first + page - 1) & ~(page - 1);
+      uintptr_t end = (uintptr_t)last & ~(page - 1);
+      if (begin < end && madvise((void*)begin, end - begin, MADV_DONTNEED) == 0)
+        return end - begin;
+#else
+      (void)first;
+      (void)last;
+#endif
+      return 0;
+    }
+  }
+};
+
+
+#endif
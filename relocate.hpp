@@ -0,0 +1,149 @@
+#ifndef BOOST_CONTAINER_CONTAINER_RELOCATE_HPP
+#define BOOST_CONTAINER_CONTAINER_RELOCATE_HPP
+
+/*
+  Relocation of elements to a new buffer, for the growth and shrink paths of the containers
+
+  Relocating n elements means constructing them at dest from the ones at first, and destroying the originals, so that
+  [first, first+n) ends up as raw memory. Which way is both correct and fastest depends on T:
+     + is_trivially_relocatable<T>: the bytes can simply be copied (memcpy), the originals are never destroyed
+     + a move constructor that can't throw (or no copy constructor at all): move construct every element
+     + otherwise: copy construct every element, and if one of the copies throws, destroy the ones already made and
+       rethrow, so the originals are untouched (strong guarantee). The originals are only destroyed at the very end.
+  This is the std::move_if_noexcept choice std::vector makes, plus the memcpy shortcut.
+
+  relocate_overlapping shifts elements inside the same buffer (for the middle insert and erase of devector). It
+  can't leave a hole halfway, so it's only for is_nothrow_relocatable types, and uses memmove for the trivial ones.
+
+  default_init constructs elements in raw memory without value initializing them (for resize_default_init), which
+  for trivial types means doing nothing at all.
+
+  is_trivially_relocatable is true for trivially copyable types, and is opt-in for everything else: a type that
+  doesn't keep pointers into itself (and isn't pointed to from outside) is trivially relocatable even if it has
+  user defined copy and move constructors, e.g.
+     namespace boost { template <> struct is_trivially_relocatable<my_handle> : std::true_type {}; }
+  std::unique_ptr with the default deleter is marked so here, and so is a std::pair of trivially relocatable types.
+  std::string is NOT (libstdc++ keeps a pointer to its own small string buffer), and neither is anything registered
+  by address somewhere else.
+ */
+
+//We include cstring for memcpy and memmove
+#include <cstring>
+//We include memory for std::unique_ptr
+#include <memory>
+//We include new for the placement new of default_init
+#include <new>
+//We include type_traits for the relocation strategy
+#include <type_traits>
+//We include utility for std::move_if_noexcept
+#include <utility>
+
+namespace boost {
+  template <typename T>
+  struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+  template <typename T>
+  struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T> > > : std::true_type {};
+
+  template <typename T1, typename T2>
+  struct is_trivially_relocatable<std::pair<T1, T2> >
+    : std::integral_constant<bool, is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
+  /*
+    Whether relocate can't throw
+   */
+  template <typename T>
+  struct is_nothrow_relocatable : std::integral_constant<bool, is_trivially_relocatable<T>::value ||
+                                                               std::is_nothrow_move_constructible<T>::value> {};
+
+  namespace detail {
+    template <class Alloc, typename T>
+    void relocate(Alloc&, T* first, T* last, T* dest, std::true_type) noexcept {
+      if (first != last)
+        memcpy((void*)dest, (const void*)first, (last - first) * sizeof(T));
+    }
+
+    template <class Alloc, typename T>
+    void relocate(Alloc& a, T* first, T* last, T* dest, std::false_type) {
+      T* cur = dest;
+      try {
+        for (T* p=first; p!=last; ++p, ++cur) {
+          a.construct(cur, std::move_if_noexcept(*p));
+        }
+      } catch (...) {
+        for (T* p=dest; p!=cur; ++p) {
+          a.destroy(p);
+        }
+        throw;
+      }
+      for (T* p=first; p!=last; ++p) {
+        a.destroy(p);
+      }
+    }
+
+    template <class Alloc, typename T>
+    void relocate_overlapping(Alloc&, T* first, T* last, T* dest, std::true_type) noexcept {
+      if (first != last)
+        memmove((void*)dest, (const void*)first, (last - first) * sizeof(T));
+    }
+
+    template <class Alloc, typename T>
+    void relocate_overlapping(Alloc& a, T* first, T* last, T* dest, std::false_type) noexcept {
+      if (dest < first) {
+        for (T* p=first; p!=last; ++p, ++dest) {
+          a.construct(dest, std::move(*p));
+          a.destroy(p);
+        }
+      } else if (dest > first) {
+        for (T* p=last, *d=dest+(last-first); p!=first; ) {
+          a.construct(--d, std::move(*--p));
+          a.destroy(p);
+        }
+      }
+    }
+  }
+
+  /*
+    Relocates [first, last) to the uninitialized, non overlapping memory at dest.
+    Strong guarantee, unless T has a throwing move constructor and no copy constructor (then the elements already
+    moved are lost, as with std::vector)
+   */
+  template <class Alloc, typename T>
+  void relocate(Alloc& a, T* first, T* last, T* dest) noexcept(is_nothrow_relocatable<T>::value) {
+    detail::relocate(a, first, last, dest, typename is_trivially_relocatable<T>::type());
+  }
+
+  /*
+    Relocates [first, last) to dest, where [dest, dest + (last - first)) may overlap it. Whatever part of the source
+    range isn't overwritten is left as raw memory. Never throws
+   */
+  template <class Alloc, typename T>
+  void relocate_overlapping(Alloc& a, T* first, T* last, T* dest) noexcept {
+    static_assert(is_nothrow_relocatable<T>::value, "relocate_overlapping needs a nothrow relocatable type");
+    detail::relocate_overlapping(a, first, last, dest, typename is_trivially_relocatable<T>::type());
+  }
+
+  /*
+    Default initializes the raw memory [first, last) (a no-op for trivial types). If a constructor throws, the
+    elements already constructed are destroyed again
+   */
+  template <typename T>
+  void default_init(T* first, T* last) {
+    if (std::is_trivially_default_constructible<T>::value)
+      return;
+    T* cur = first;
+    try {
+      for (; cur!=last; ++cur) {
+        ::new ((void*)cur) T;
+      }
+    } catch (...) {
+      for (T* p=first; p!=cur; ++p) {
+        p->~T();
+      }
+      throw;
+    }
+  }
+};
+
+
+#endif
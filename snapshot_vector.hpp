@@ -0,0 +1,321 @@
+#ifndef BOOST_CONTAINER_CONTAINER_SNAPSHOT_VECTOR_HPP
+#define BOOST_CONTAINER_CONTAINER_SNAPSHOT_VECTOR_HPP
+
+/*
+  C++ append-only vector with lock-free readers (RCU style)
+
+  One writer thread appends to the vector, any number of reader threads read it concurrently, without any lock.
+  A reader takes a snapshot, which is an immutable (pointer, size) view of the vector at that moment, and keeps
+  the buffer alive until the snapshot is released.
+     + push_back constructs the new element after the published size, and then publishes the new size.
+       Elements below a published size are never modified, so snapshots taken before the push are unaffected.
+     + When the buffer is full, push_back copies the elements to a bigger buffer and publishes it instead.
+       The old buffer is kept alive until the last snapshot referencing it is released.
+
+  Reclamation uses split reference counting: the published word packs the buffer pointer (low 48 bits)
+  together with an external count (high 16 bits). Taking a snapshot is a single fetch_add on that word, which
+  reads the pointer and references the buffer in the same atomic operation, so no buffer can be freed between the
+  two. Releasing a snapshot decrements the buffer's internal count. While a buffer is published its internal count
+  carries a large bias, so it can only reach zero after the writer has retired the buffer and folded the external
+  count into it. The external count is folded into the internal one every 2^14 snapshots so it never overflows.
+  This requires user space pointers to fit in 48 bits, which holds on x86-64 and AArch64.
+
+  Only one thread may call the writer functions (push_back, reserve, clear) at a time.
+  Elements are copied (not moved) on growth, as readers may still be reading the old ones.
+ */
+
+#include "vector.hpp"
+//We include atomic for the published buffer and the reference counts
+#include <atomic>
+//We include cstdint for uintptr_t
+#include <cstdint>
+
+namespace boost {
+  template <typename T, class Alloc = std::allocator<T> >
+  class snapshot_vector {
+  public:
+    //types:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef const value_type& const_reference;
+    typedef const T* const_iterator;
+    typedef unsigned int size_type;
+    typedef size_type difference_type;
+
+  private:
+    struct block {
+      std::atomic<size_type> size; //published number of elements
+      size_type capacity; //number of allocated elements
+      std::atomic<long long> internal; //internal reference count (biased while the block is published)
+      Alloc allocator; //allocator for data, so the last reader can free it
+      T* data; //array of elements
+    };
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<block> block_allocator_type;
+
+    static const int PTR_BITS = 48;
+    static const uint64_t PTR_MASK = (((uint64_t)1) << PTR_BITS) - 1;
+    static const uint64_t ONE_EXTERNAL = ((uint64_t)1) << PTR_BITS;
+    static const uint64_t FOLD_THRESHOLD = 1 << 14;
+    static const long long PUBLISHED_BIAS = ((long long)1) << 40;
+
+  public:
+    /*
+      Immutable view of the vector. Copying a snapshot references the same buffer again.
+     */
+    class snapshot {
+    public:
+      snapshot() noexcept : m_block(NULL), m_data(NULL), m_size(0) {}
+
+      snapshot(const snapshot& other) noexcept : m_block(other.m_block), m_data(other.m_data), m_size(other.m_size) {
+        if (m_block != NULL)
+          m_block->internal.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      snapshot(snapshot&& other) noexcept : m_block(other.m_block), m_data(other.m_data), m_size(other.m_size) {
+        other.m_block = NULL;
+        other.m_data = NULL;
+        other.m_size = 0;
+      }
+
+      snapshot& operator=(snapshot other) noexcept {
+        std::swap(m_block, other.m_block);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+      }
+
+      ~snapshot() noexcept {
+        if (m_block != NULL)
+          priv_unreference(m_block, 1);
+      }
+
+      size_type size() const noexcept {
+        return m_size;
+      }
+
+      bool empty() const noexcept {
+        return m_size == 0;
+      }
+
+      const_reference operator[](size_type n) const {
+        return at(n);
+      }
+
+      const_reference at(size_type n) const {
+        if (n >= m_size)
+          throw exceptions::out_of_bounds();
+        return m_data[n];
+      }
+
+      const T* data() const noexcept {
+        return m_data;
+      }
+
+      const_iterator begin() const noexcept {
+        return m_data;
+      }
+
+      const_iterator end() const noexcept {
+        return m_data + m_size;
+      }
+
+    private:
+      friend class snapshot_vector;
+      snapshot(block* b) noexcept : m_block(b), m_data(b->data), m_size(b->size.load(std::memory_order_acquire)) {}
+
+      block* m_block;
+      const T* m_data;
+      size_type m_size;
+    };
+
+  /*
+  ========================================
+  Member functions
+  ========================================
+  */
+    snapshot_vector() : m_size(0) {
+      m_current = priv_create_block(1);
+      m_state.store((uint64_t)(uintptr_t)m_current, std::memory_order_release);
+    }
+
+    /*
+      Destructor. Snapshots may outlive the vector, the last one frees the buffer.
+     */
+    ~snapshot_vector() noexcept {
+      priv_retire(0);
+    }
+
+    snapshot_vector(const snapshot_vector&) = delete;
+    snapshot_vector& operator=(const snapshot_vector&) = delete;
+
+  /*
+  ========================================
+  Readers
+  ========================================
+  */
+    /*
+      Lock-free: one atomic fetch_add and, every 2^14 calls, one compare exchange
+     */
+    snapshot read() const noexcept {
+      uint64_t old = m_state.fetch_add(ONE_EXTERNAL, std::memory_order_acq_rel);
+      block* b = priv_block(old);
+      if ((old >> PTR_BITS) + 1 >= FOLD_THRESHOLD)
+        priv_fold(b);
+      return snapshot(b);
+    }
+
+  /*
+  ========================================
+  Writer
+  ========================================
+  */
+    size_type size() const noexcept {
+      return m_size;
+    }
+
+    size_type capacity() const noexcept {
+      return m_current->capacity;
+    }
+
+    bool empty() const noexcept {
+      return m_size == 0;
+    }
+
+    const_reference operator[](size_type n) const {
+      if (n >= m_size)
+        throw exceptions::out_of_bounds();
+      return m_current->data[n];
+    }
+
+    /*
+      Publishes a copy of the elements in a buffer of capacity n, if n > capacity()
+     */
+    void reserve(size_type n) {
+      if (n > m_current->capacity)
+        priv_publish(priv_copy_block(n));
+    }
+
+    void push_back(const T& x) {
+      if (m_size >= m_current->capacity) {
+        size_type n = (m_current->capacity + VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT);
+        block * b = priv_copy_block(n > m_size ? n : m_size + 1);
+        try {
+          b->allocator.construct(b->data + m_size, x);
+        } catch (...) {
+          priv_destroy_block(b, m_size);
+          throw;
+        }
+        b->size.store(m_size + 1, std::memory_order_relaxed);
+        m_size++;
+        priv_publish(b);
+      } else {
+        m_current->allocator.construct(m_current->data + m_size, x);
+        m_size++;
+        m_current->size.store(m_size, std::memory_order_release);
+      }
+    }
+
+    /*
+      Publishes a new empty buffer. Existing snapshots keep seeing the old elements.
+     */
+    void clear() {
+      block * b = priv_create_block(1);
+      m_size = 0;
+      priv_publish(b);
+    }
+
+  private:
+    mutable std::atomic<uint64_t> m_state; //external count << PTR_BITS | pointer to the published block
+    block* m_current; //published block (only read by the writer)
+    size_type m_size; //number of elements in m_current (only read by the writer)
+
+    static block* priv_block(uint64_t state) noexcept {
+      return (block*)(uintptr_t)(state & PTR_MASK);
+    }
+
+    static block* priv_create_block(size_type capacity) {
+      block_allocator_type block_allocator;
+      block * b = block_allocator.allocate(1);
+      ::new ((void*)b) block();
+      b->size.store(0, std::memory_order_relaxed);
+      b->capacity = capacity;
+      b->internal.store(PUBLISHED_BIAS, std::memory_order_relaxed);
+      try {
+        b->data = b->allocator.allocate(capacity);
+      } catch (...) {
+        b->~block();
+        block_allocator.deallocate(b, 1);
+        throw;
+      }
+      if (((uint64_t)(uintptr_t)b & ~PTR_MASK) != 0) {
+        priv_destroy_block(b, 0);
+        throw std::bad_alloc();
+      }
+      return b;
+    }
+
+    /*
+      Returns a new block of capacity n holding copies of the current m_size elements
+     */
+    block* priv_copy_block(size_type n) {
+      block * b = priv_create_block(n);
+      size_type i = 0;
+      try {
+        for (; i<m_size; i++) {
+          b->allocator.construct(b->data + i, m_current->data[i]);
+        }
+      } catch (...) {
+        priv_destroy_block(b, i);
+        throw;
+      }
+      b->size.store(m_size, std::memory_order_relaxed);
+      return b;
+    }
+
+    static void priv_destroy_block(block* b, size_type constructed) noexcept {
+      for (size_type i=0; i<constructed; i++) {
+        b->allocator.destroy(b->data + i);
+      }
+      b->allocator.deallocate(b->data, b->capacity);
+      b->~block();
+      block_allocator_type block_allocator;
+      block_allocator.deallocate(b, 1);
+    }
+
+    static void priv_unreference(block* b, long long n) noexcept {
+      if (b->internal.fetch_sub(n, std::memory_order_acq_rel) == n)
+        priv_destroy_block(b, b->size.load(std::memory_order_relaxed));
+    }
+
+    /*
+      Moves the external count of b into its internal count. The caller holds a reference to b.
+      The internal count is raised first, so the total never undercounts while the exchange is in flight.
+     */
+    void priv_fold(block* b) const noexcept {
+      uint64_t cur = m_state.load(std::memory_order_relaxed);
+      if (priv_block(cur) != b)
+        return;
+      long long external = (long long)(cur >> PTR_BITS);
+      b->internal.fetch_add(external, std::memory_order_relaxed);
+      if (!m_state.compare_exchange_strong(cur, (uint64_t)(uintptr_t)b, std::memory_order_acq_rel))
+        priv_unreference(b, external);
+    }
+
+    void priv_publish(block* b) noexcept {
+      priv_retire((uint64_t)(uintptr_t)b);
+      m_current = b;
+    }
+
+    /*
+      Replaces the published block by new_state and drops the writer's (biased) reference to the old one
+     */
+    void priv_retire(uint64_t new_state) noexcept {
+      uint64_t old = m_state.exchange(new_state, std::memory_order_acq_rel);
+      long long external = (long long)(old >> PTR_BITS);
+      priv_unreference(priv_block(old), PUBLISHED_BIAS - external);
+    }
+  };
+};
+
+
+#endif
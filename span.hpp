@@ -0,0 +1,70 @@
+#ifndef BOOST_CONTAINER_CONTAINER_SPAN_HPP
+#define BOOST_CONTAINER_CONTAINER_SPAN_HPP
+
+/*
+  Minimal C++11 stand-in for std::span (C++20): a pointer and a number of elements, viewing memory owned by someone
+  else (e.g. the uninitialized tail returned by vector::append_uninitialized). It is only valid as long as that
+  memory is, so any reallocation of the owning container invalidates it.
+ */
+
+//We include cstddef for std::size_t
+#include <cstddef>
+
+namespace boost {
+  template <typename T>
+  class span {
+  public:
+    //types:
+    typedef T element_type;
+    typedef T* iterator;
+    typedef T& reference;
+    typedef std::size_t size_type;
+
+    span() noexcept : m_data(NULL), m_size(0) {}
+
+    span(T* data, size_type size) noexcept : m_data(data), m_size(size) {}
+
+    T* data() const noexcept {
+      return m_data;
+    }
+
+    size_type size() const noexcept {
+      return m_size;
+    }
+
+    size_type size_bytes() const noexcept {
+      return m_size * sizeof(T);
+    }
+
+    bool empty() const noexcept {
+      return m_size == 0;
+    }
+
+    iterator begin() const noexcept {
+      return m_data;
+    }
+
+    iterator end() const noexcept {
+      return m_data + m_size;
+    }
+
+    reference operator[](size_type n) const {
+      return m_data[n]; //no bounds checking, as in std::span
+    }
+
+    span first(size_type n) const {
+      return span(m_data, n);
+    }
+
+    span last(size_type n) const {
+      return span(m_data + m_size - n, n);
+    }
+
+  private:
+    T* m_data;
+    size_type m_size;
+  };
+};
+
+
+#endif
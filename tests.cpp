@@ -1,10 +1,15 @@
+//The automatic shrink is opt in, these tests cover it
+#define VECTOR_SHRINK_DIV 4
 #include "vector.hpp"
+#include <cstring>
+#include <memory>
 #include <string>
+#include <unistd.h>
 #define BOOST_TEST_DYN_LYNK
 #define BOOST_TEST_MODULE BoostExampleVector
 #include <boost/test/included/unit_test.hpp>
 /*
-  This file includes unit tests for vector<int> and for vector<string>
+  This file includes unit tests for vector<int> and for vector<string>, and for the relocation of elements on growth
  */
 
 /*
@@ -161,11 +166,127 @@ BOOST_AUTO_TEST_CASE(vector_int_modifiers) {
   BOOST_CHECK_NO_THROW(vi.pop_back());
   BOOST_CHECK(vi[2]==2);
   BOOST_CHECK_THROW(vi[3]++, boost::exceptions::out_of_bounds);
+  //clear keeps the buffer, so the same number of elements fits again without growing
+  boost::vector<int>::size_type capacity = vi.capacity();
+  int* data = vi.data();
+  vi.clear();
+  BOOST_CHECK(vi.empty() && vi.capacity()==capacity);
+  for (boost::vector<int>::size_type i=0; i<capacity; i++) {
+    BOOST_CHECK_NO_THROW(vi.push_back(i));
+  }
+  BOOST_CHECK(vi.data()==data);
+}
+
+
+//tests vector<int>() automatic shrink and its hysteresis
+BOOST_AUTO_TEST_CASE(vector_int_auto_shrink) {
+  boost::vector<int> vi;
+  for (int i=0; i<100000; i++) {
+    vi.pre_push_back();
+    vi.push_back(i);
+  }
+  boost::vector<int>::size_type peak = vi.capacity();
+  while (vi.size() >= peak / VECTOR_SHRINK_DIV) {
+    BOOST_CHECK(vi.capacity()==peak);
+    vi.pop_back();
+  }
+  BOOST_CHECK(vi.capacity()==vi.size() * VECTOR_SHRINK_MULT);
+  boost::vector<int>::size_type shrunk = vi.capacity();
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK_NO_THROW(vi.push_back(i));
+    BOOST_CHECK_NO_THROW(vi.pop_back());
+  }
+  BOOST_CHECK(vi.capacity()==shrunk);
+  for (boost::vector<int>::size_type i=0; i<vi.size(); i++) {
+    BOOST_CHECK(vi[i]==(int)i);
+  }
+  //small vectors are left alone
+  boost::vector<int> vi2(10);
+  vi2.push_back(1);
+  vi2.pop_back();
+  BOOST_CHECK(vi2.capacity()==10);
+}
+
+//tests that the automatic shrink keeps the capacity reserved with vector(n) and reserve(n), so push_back (which
+//doesn't grow) still fits after draining
+BOOST_AUTO_TEST_CASE(vector_int_auto_shrink_keeps_reserved) {
+  boost::vector<int> vi(100000);
+  for (int cycle=0; cycle<2; cycle++) {
+    for (int i=0; i<100000; i++) {
+      BOOST_CHECK_NO_THROW(vi.push_back(i));
+    }
+    while (!vi.empty()) {
+      vi.pop_back();
+    }
+    BOOST_CHECK(vi.capacity()==100000);
+  }
+  boost::vector<int> vr;
+  vr.reserve(50000);
+  for (int i=0; i<50000; i++) {
+    vr.push_back(i);
+  }
+  while (!vr.empty()) {
+    vr.pop_back();
+  }
+  BOOST_CHECK(vr.capacity()==50000);
+  BOOST_CHECK_NO_THROW(vr.push_back(1));
+  //elements bigger than SHRINK_MIN_BYTES don't shrink an empty vector to nothing
+  struct big {
+    char bytes[VECTOR_SHRINK_MIN_BYTES * 2];
+  };
+  boost::vector<big> vb;
+  for (int i=0; i<16; i++) {
+    vb.pre_push_back();
+    vb.push_back(big());
+  }
+  while (!vb.empty()) {
+    vb.pop_back();
+  }
+  BOOST_CHECK(vb.capacity()==1);
+  BOOST_CHECK_NO_THROW(vb.push_back(big()));
 }
 
 
 
 
+//Tests reading from a pipe straight into vector<char> with append_uninitialized and commit
+BOOST_AUTO_TEST_CASE(vector_char_append_uninitialized) {
+  int fds[2];
+  BOOST_REQUIRE(pipe(fds)==0);
+  const char message[] = "bytes that land directly in the vector";
+  BOOST_REQUIRE(write(fds[1], message, sizeof(message))==(ssize_t)sizeof(message));
+  close(fds[1]);
+  boost::vector<char> v;
+  v.pre_push_back();
+  v.push_back('>');
+  ssize_t k;
+  do {
+    boost::span<char> tail = v.append_uninitialized(8);
+    BOOST_CHECK(tail.size()==8);
+    BOOST_CHECK(tail.data()==v.data() + v.size());
+    k = read(fds[0], tail.data(), tail.size());
+    v.commit(k > 0 ? k : 0);
+  } while (k > 0);
+  close(fds[0]);
+  BOOST_CHECK(v.size()==1 + sizeof(message));
+  BOOST_CHECK(memcmp(v.data() + 1, message, sizeof(message))==0);
+  BOOST_CHECK_THROW(v.commit(v.capacity()), boost::exceptions::buffer_overflow);
+}
+
+//Tests vector<int> resize_default_init
+BOOST_AUTO_TEST_CASE(vector_int_resize_default_init) {
+  boost::vector<int> vi({1, 2, 3});
+  vi.resize_default_init(100);
+  BOOST_CHECK(vi.size()==100);
+  BOOST_CHECK(vi.capacity()==100);
+  BOOST_CHECK(vi[2]==3);
+  vi[99] = 99;
+  vi.resize_default_init(2);
+  BOOST_CHECK(vi.size()==2);
+  BOOST_CHECK(vi.capacity()==100);
+  BOOST_CHECK(vi[1]==2);
+}
+
 /*
   ==========================
   Vector<string> tests
@@ -318,3 +439,70 @@ BOOST_AUTO_TEST_CASE(vector_string_modifiers) {
   BOOST_CHECK(vi[2]=="2");
   BOOST_CHECK_THROW(vi[3], boost::exceptions::out_of_bounds);
 }
+
+/*
+  ==========================
+  Relocation tests
+  ==========================
+*/
+
+//Element whose move constructor may throw, so relocation has to copy, and whose copies throw on demand
+struct throwing_copy {
+  static int live;
+  static int copies_left;
+  int value;
+  throwing_copy() : value(0) { live++; }
+  throwing_copy(const throwing_copy& o) : value(o.value) {
+    if (copies_left-- == 0)
+      throw std::bad_alloc();
+    live++;
+  }
+  throwing_copy(throwing_copy&& o) : value(o.value) { live++; }
+  throwing_copy& operator=(const throwing_copy& o) { value = o.value; return *this; }
+  ~throwing_copy() { live--; }
+};
+int throwing_copy::live = 0;
+int throwing_copy::copies_left = -1;
+
+//Tests a move only, trivially relocatable element type through growth and shrink
+BOOST_AUTO_TEST_CASE(vector_unique_ptr_relocation) {
+  BOOST_CHECK(boost::is_trivially_relocatable<std::unique_ptr<int> >::value);
+  BOOST_CHECK(!boost::is_trivially_relocatable<std::string>::value);
+  boost::vector<std::unique_ptr<int> > vi;
+  for (int i=0; i<5000; i++) {
+    vi.pre_push_back();
+    vi.push_back(std::unique_ptr<int>(new int(i)));
+  }
+  while (vi.size() > 10) {
+    vi.pop_back();
+  }
+  vi.shrink_to_fit();
+  for (int i=0; i<10; i++) {
+    BOOST_CHECK(*vi[i]==i);
+  }
+}
+
+//Tests that reserve keeps the elements untouched if copying them to the new buffer throws
+BOOST_AUTO_TEST_CASE(vector_relocation_strong_guarantee) {
+  {
+    boost::vector<throwing_copy> vi(10);
+    for (int i=0; i<10; i++) {
+      throwing_copy x;
+      x.value = i;
+      vi.push_back(x);
+    }
+    BOOST_CHECK(throwing_copy::live==10);
+    throwing_copy::copies_left = 5;
+    BOOST_CHECK_THROW(vi.reserve(20), std::bad_alloc);
+    throwing_copy::copies_left = -1;
+    BOOST_CHECK(throwing_copy::live==10);
+    BOOST_CHECK(vi.capacity()==10);
+    for (int i=0; i<10; i++) {
+      BOOST_CHECK(vi[i].value==i);
+    }
+    vi.reserve(20);
+    BOOST_CHECK(throwing_copy::live==10);
+    BOOST_CHECK(vi[9].value==9);
+  }
+  BOOST_CHECK(throwing_copy::live==0);
+}
@@ -0,0 +1,93 @@
+#include "aligned_allocator.hpp"
+#include "vector.hpp"
+#include "devector_project/devector.hpp"
+#include <cstdint>
+#include <string>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleAlignedAllocator
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for aligned_allocator, aligned_vector and aligned_devector
+ */
+
+static bool is_aligned(const void* p, std::size_t align) {
+  return ((std::uintptr_t)p) % align == 0;
+}
+
+//Tests aligned_allocator allocations, rebind and the allocator traits
+BOOST_AUTO_TEST_CASE(aligned_allocator_allocate) {
+  boost::aligned_allocator<char, 64> a;
+  BOOST_CHECK(a.allocate(0)==NULL);
+  for (std::size_t n=1; n<200; n+=7) {
+    char* p = a.allocate(n);
+    BOOST_CHECK(is_aligned(p, 64));
+    //the allocation is rounded up to a whole number of 64 byte blocks
+    for (std::size_t i=0; i<(n + 63) / 64 * 64; i++) {
+      p[i] = (char)i;
+    }
+    a.deallocate(p, n);
+  }
+  boost::aligned_allocator<double, 32>::rebind<int>::other b;
+  int* q = b.allocate(3);
+  BOOST_CHECK(is_aligned(q, 32));
+  b.deallocate(q, 3);
+  BOOST_CHECK((a==boost::aligned_allocator<int, 64>()));
+  BOOST_CHECK((boost::allocator_alignment<boost::aligned_allocator<int, 32> >::value==32));
+  BOOST_CHECK((boost::allocator_alignment<std::allocator<int> >::value==alignof(int)));
+  BOOST_CHECK((boost::can_release_pages<boost::aligned_allocator<int> >::value));
+}
+
+//Tests that aligned_vector's data() stays aligned while it grows and shrinks
+BOOST_AUTO_TEST_CASE(aligned_vector_int) {
+  boost::aligned_vector<int> vi;
+  for (int i=0; i<10000; i++) {
+    vi.pre_push_back();
+    vi.push_back(i);
+    BOOST_CHECK(is_aligned(vi.data(), 64));
+  }
+  while (vi.size() > 10) {
+    vi.pop_back();
+    BOOST_CHECK(is_aligned(vi.data(), 64));
+  }
+  for (int i=0; i<10; i++) {
+    BOOST_CHECK(vi[i]==i);
+  }
+}
+
+//Tests that aligned_devector's data() is aligned after every reallocation, from either end
+BOOST_AUTO_TEST_CASE(aligned_devector_int) {
+  boost::aligned_devector<int> vi;
+  for (int i=0; i<10000; i++) {
+    boost::aligned_devector<int>::size_type capacity = vi.capacity();
+    if (i % 2)
+      vi.push_back(i);
+    else
+      vi.push_front(i);
+    //the old front lands on an aligned element (small buffers don't have one with free room in front of it)
+    if (vi.capacity() != capacity && vi.capacity() >= 64)
+      BOOST_CHECK(is_aligned(vi.data() + (i % 2 ? 0 : 1), 64));
+  }
+  vi.reserve(100000);
+  BOOST_CHECK(is_aligned(vi.data(), 64));
+  vi.shrink_to_fit();
+  BOOST_CHECK(is_aligned(vi.data(), 64));
+  BOOST_CHECK(vi.front()==9998);
+  BOOST_CHECK(vi.back()==9999);
+  vi.clear();
+  vi.push_back(1);
+  BOOST_CHECK(is_aligned(vi.data(), 64));
+}
+
+//Tests an element type whose size doesn't divide the alignment
+BOOST_AUTO_TEST_CASE(aligned_devector_odd_size) {
+  struct rgb { char c[3]; };
+  boost::aligned_devector<rgb, 32> vi;
+  for (int i=0; i<1000; i++) {
+    rgb x = {{(char)i, 0, 0}};
+    vi.push_front(x);
+    vi.push_back(x);
+  }
+  vi.reserve(5000);
+  BOOST_CHECK(is_aligned(vi.data(), 32));
+  BOOST_CHECK(vi.front().c[0]==(char)999);
+}
@@ -0,0 +1,147 @@
+#include "flat_hash_map.hpp"
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleFlatHashMap
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for flat_hash_map
+ */
+
+//Hashes std::string and const char* alike, for the heterogeneous lookups
+struct string_hash {
+  typedef void is_transparent;
+  std::size_t operator()(const std::string& s) const { return (*this)(s.c_str()); }
+  std::size_t operator()(const char* s) const {
+    std::size_t h = 14695981039346656037ull;
+    for (; *s; s++) {
+      h = (h ^ (unsigned char)*s) * 1099511628211ull;
+    }
+    return h;
+  }
+};
+
+struct string_equal {
+  typedef void is_transparent;
+  bool operator()(const std::string& a, const std::string& b) const { return a == b; }
+  bool operator()(const std::string& a, const char* b) const { return a == b; }
+};
+
+//Hash that throws on its Nth call from now on (0 never throws)
+static int hash_calls_left = 0;
+struct throwing_hash {
+  std::size_t operator()(int k) const {
+    if (hash_calls_left > 0 && --hash_calls_left == 0)
+      throw std::runtime_error("hash");
+    return std::hash<int>()(k);
+  }
+};
+
+//Tests flat_hash_map<int, int> insert, find, erase and growth against std::map
+BOOST_AUTO_TEST_CASE(flat_hash_map_int_int) {
+  boost::flat_hash_map<int, int> m;
+  BOOST_CHECK(m.empty());
+  BOOST_CHECK(m.find(1)==NULL);
+  BOOST_CHECK(m.erase(1)==0);
+  std::map<int, int> expected;
+  for (int i=0; i<10000; i++) {
+    int k = (i * 7919) % 5000 * 128; //multiples of 128 share the low bits of their (identity) hash
+    BOOST_CHECK(m.insert(k, i)==expected.insert(std::make_pair(k, i)).second);
+  }
+  BOOST_CHECK(m.size()==expected.size());
+  BOOST_CHECK(m.load_factor() <= 7.0f / 8);
+  for (int i=0; i<5000; i++) {
+    int* v = m.find(i * 128);
+    BOOST_CHECK(v!=NULL && *v==expected[i * 128]);
+    BOOST_CHECK(m.find(i * 128 + 1)==NULL);
+  }
+  for (int i=0; i<5000; i+=2) {
+    BOOST_CHECK(m.erase(i * 128)==1);
+  }
+  BOOST_CHECK(m.erase(0)==0);
+  BOOST_CHECK(m.size()==2500);
+  for (int i=0; i<5000; i++) {
+    BOOST_CHECK(m.count(i * 128)==(unsigned)(i % 2));
+  }
+  BOOST_CHECK_THROW(m.at(0), boost::exceptions::out_of_bounds);
+  m[0] = 3;
+  m[0] += 1;
+  BOOST_CHECK(m.at(0)==4);
+}
+
+//Tests that insert/erase churn reuses the deleted slots instead of growing forever
+BOOST_AUTO_TEST_CASE(flat_hash_map_churn) {
+  boost::flat_hash_map<int, int> m;
+  m.reserve(1000);
+  boost::flat_hash_map<int, int>::size_type capacity = m.capacity();
+  BOOST_CHECK(capacity >= 1000);
+  for (int i=0; i<100000; i++) {
+    m.insert(i, i);
+    if (i >= 500)
+      BOOST_CHECK(m.erase(i - 500)==1);
+  }
+  BOOST_CHECK(m.size()==500);
+  BOOST_CHECK(m.capacity()==capacity);
+  long long sum = 0;
+  for (boost::flat_hash_map<int, int>::iterator it=m.begin(); it!=m.end(); ++it) {
+    BOOST_CHECK(it->first==it->second);
+    sum += it->first;
+  }
+  BOOST_CHECK(sum==500LL * (99500 + 99999) / 2);
+  m.clear();
+  BOOST_CHECK(m.empty() && m.begin()==m.end());
+  BOOST_CHECK(m.capacity()==capacity);
+}
+
+//Tests string keys with heterogeneous lookups, a custom growth policy and a move only value
+BOOST_AUTO_TEST_CASE(flat_hash_map_string) {
+  boost::flat_hash_map<std::string, std::unique_ptr<int>, string_hash, string_equal,
+                       std::allocator<std::pair<std::string, std::unique_ptr<int> > >, boost::hash_growth_policy<1, 2> > m;
+  for (int i=0; i<1000; i++) {
+    m[std::string(i % 20, 'x') + std::to_string(i)].reset(new int(i));
+  }
+  BOOST_CHECK(m.size()==1000);
+  BOOST_CHECK(m.load_factor() <= 0.5f);
+  char key[64];
+  for (int i=0; i<1000; i++) {
+    memset(key, 'x', i % 20);
+    strcpy(key + i % 20, std::to_string(i).c_str());
+    std::unique_ptr<int>* v = m.find((const char*)key);
+    BOOST_CHECK(v!=NULL && **v==i);
+  }
+  BOOST_CHECK(m.count("nope")==0);
+  BOOST_CHECK(m.count(std::string("x1"))==1);
+}
+
+//Tests that a hash throwing halfway through a rehash leaves the table and its elements intact, for a trivially
+//relocatable value (moved with memcpy) and for one that is moved with its move constructor
+BOOST_AUTO_TEST_CASE(flat_hash_map_throwing_hash) {
+  boost::flat_hash_map<int, std::unique_ptr<int>, throwing_hash> owners;
+  boost::flat_hash_map<int, std::string, throwing_hash> names;
+  int n = 0;
+  while (owners.size() == 0 || owners.size() < owners.capacity() * 7 / 8) {
+    owners[n].reset(new int(n));
+    names[n] = std::string(30, 'n') + std::to_string(n);
+    n++;
+  }
+  boost::flat_hash_map<int, std::unique_ptr<int>, throwing_hash>::size_type capacity = owners.capacity();
+  hash_calls_left = n / 2 + 2; //the key, then half the elements being rehashed
+  BOOST_CHECK_THROW(owners[n].reset(new int(n)), std::runtime_error);
+  hash_calls_left = n / 2 + 2;
+  BOOST_CHECK_THROW(names[n] = "new", std::runtime_error);
+  hash_calls_left = 0;
+  BOOST_CHECK(owners.capacity()==capacity && owners.size()==(unsigned)n);
+  BOOST_CHECK(names.size()==(unsigned)n);
+  int wrong = 0;
+  for (int i=0; i<n; i++) {
+    wrong += (owners.count(i) != 1 || *owners[i] != i);
+    wrong += (names[i] != std::string(30, 'n') + std::to_string(i));
+  }
+  BOOST_CHECK(wrong==0);
+  //and the next rehash goes through
+  owners[n].reset(new int(n));
+  BOOST_CHECK(owners.capacity() > capacity && *owners[n]==n && *owners[0]==0);
+}
@@ -0,0 +1,86 @@
+#include "incremental_vector.hpp"
+#include <string>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleIncrementalVector
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for incremental_vector<int> and for incremental_vector<string>
+ */
+
+//Tests that elements stay reachable while a growth is being migrated
+BOOST_AUTO_TEST_CASE(incremental_vector_int_push_back) {
+  boost::incremental_vector<int> vi;
+  BOOST_CHECK(vi.size()==0);
+  BOOST_CHECK(vi.capacity()==0);
+  BOOST_CHECK_THROW(vi[0], boost::exceptions::out_of_bounds);
+  bool seen_migration = false;
+  for (int i=0; i<1000; i++) {
+    BOOST_CHECK_NO_THROW(vi.push_back(i));
+    seen_migration = seen_migration || vi.migrating();
+    BOOST_CHECK(vi.back()==i);
+    BOOST_CHECK(vi.front()==0);
+    BOOST_CHECK(vi[i/2]==i/2);
+  }
+  BOOST_CHECK(seen_migration);
+  BOOST_CHECK(vi.size()==1000);
+  for (int i=0; i<1000; i++) {
+    BOOST_CHECK(vi[i]==i);
+  }
+}
+
+//Tests that a growth is fully migrated before the new buffer fills up
+BOOST_AUTO_TEST_CASE(incremental_vector_int_migration_bound) {
+  boost::incremental_vector<int> vi(4);
+  for (int i=0; i<4; i++) {
+    vi.push_back(i);
+  }
+  BOOST_CHECK(!vi.migrating());
+  vi.push_back(4);
+  BOOST_CHECK(vi.migrating());
+  BOOST_CHECK(vi.capacity()==8);
+  for (int i=5; i<8; i++) {
+    vi.push_back(i);
+  }
+  BOOST_CHECK(!vi.migrating());
+  for (int i=0; i<8; i++) {
+    BOOST_CHECK(vi.data()[i]==i);
+  }
+}
+
+//Tests pop_back and data() in the middle of a migration
+BOOST_AUTO_TEST_CASE(incremental_vector_int_pop_back) {
+  boost::incremental_vector<int> vi(8);
+  for (int i=0; i<9; i++) {
+    vi.push_back(i);
+  }
+  BOOST_CHECK(vi.migrating());
+  BOOST_CHECK_NO_THROW(vi.pop_back());
+  BOOST_CHECK_NO_THROW(vi.pop_back());
+  BOOST_CHECK(vi.size()==7);
+  BOOST_CHECK(vi.back()==6);
+  int * p = vi.data();
+  BOOST_CHECK(!vi.migrating());
+  for (int i=0; i<7; i++) {
+    BOOST_CHECK(p[i]==i);
+  }
+  vi.clear();
+  BOOST_CHECK(vi.empty());
+  BOOST_CHECK_THROW(vi.pop_back(), boost::exceptions::out_of_bounds);
+}
+
+//Tests incremental_vector<string>, whose elements must be moved and not copied bitwise
+BOOST_AUTO_TEST_CASE(incremental_vector_string_push_back) {
+  boost::incremental_vector<std::string> vs;
+  for (int i=0; i<300; i++) {
+    vs.push_back(std::string(i % 40, 'a' + i % 26));
+  }
+  for (int i=0; i<300; i++) {
+    BOOST_CHECK(vs[i]==std::string(i % 40, 'a' + i % 26));
+  }
+  while (vs.size() > 100) {
+    vs.pop_back();
+  }
+  BOOST_CHECK_NO_THROW(vs.reserve(1000));
+  BOOST_CHECK(vs.capacity()==1000);
+  BOOST_CHECK(vs[99]==std::string(99 % 40, 'a' + 99 % 26));
+}
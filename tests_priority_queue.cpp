@@ -0,0 +1,116 @@
+#include "priority_queue.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExamplePriorityQueue
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for priority_queue and indexed_priority_queue
+ */
+
+/*
+  ==========================
+  priority_queue tests
+  ==========================
+*/
+
+//Tests priority_queue<int> push, top and pop against a sorted copy
+BOOST_AUTO_TEST_CASE(priority_queue_int_push_pop) {
+  boost::priority_queue<int> pq;
+  BOOST_CHECK(pq.empty());
+  BOOST_CHECK_THROW(pq.top(), boost::exceptions::out_of_bounds);
+  BOOST_CHECK_THROW(pq.pop(), boost::exceptions::out_of_bounds);
+  std::vector<int> values;
+  srand(1);
+  for (int i=0; i<1000; i++) {
+    values.push_back(rand() % 500);
+    pq.push(values.back());
+    BOOST_CHECK(pq.top()==*std::max_element(values.begin(), values.end()));
+  }
+  BOOST_CHECK(pq.size()==1000);
+  std::sort(values.begin(), values.end());
+  for (int i=999; i>=0; i--) {
+    BOOST_CHECK(pq.top()==values[i]);
+    pq.pop();
+  }
+  BOOST_CHECK(pq.empty());
+}
+
+//Tests a min-heap of arity 8 built with push_range, in both the heapify and the sift up paths
+BOOST_AUTO_TEST_CASE(priority_queue_int_push_range) {
+  boost::priority_queue<int, std::greater<int>, 8> pq;
+  std::vector<int> values;
+  for (int i=0; i<777; i++) {
+    values.push_back((i * 7919) % 1000);
+  }
+  pq.push_range(values.begin(), values.end());
+  pq.push_range(values.begin(), values.begin() + 10);
+  values.insert(values.end(), values.begin(), values.begin() + 10);
+  BOOST_CHECK(pq.size()==values.size());
+  std::sort(values.begin(), values.end());
+  for (size_t i=0; i<values.size(); i++) {
+    BOOST_CHECK(pq.top()==values[i]);
+    pq.pop();
+  }
+}
+
+//Tests pop_push and replace_top
+BOOST_AUTO_TEST_CASE(priority_queue_int_pop_push) {
+  boost::priority_queue<int> pq;
+  for (int i=0; i<10; i++) {
+    pq.push(i);
+  }
+  BOOST_CHECK(pq.pop_push(-1)==9);
+  BOOST_CHECK(pq.top()==8);
+  pq.replace_top(100);
+  BOOST_CHECK(pq.top()==100);
+  pq.replace_top(-2);
+  BOOST_CHECK(pq.top()==7);
+  BOOST_CHECK(pq.size()==10);
+  int expected[] = {7, 6, 5, 4, 3, 2, 1, 0, -1, -2};
+  for (int i=0; i<10; i++) {
+    BOOST_CHECK(pq.top()==expected[i]);
+    pq.pop();
+  }
+  pq.push(1);
+  pq.clear();
+  BOOST_CHECK(pq.empty());
+}
+
+/*
+  ==========================
+  indexed_priority_queue tests
+  ==========================
+*/
+
+//Tests indexed_priority_queue<int> push, decrease_key, update and erase
+BOOST_AUTO_TEST_CASE(indexed_priority_queue_int) {
+  boost::indexed_priority_queue<int> pq;
+  for (unsigned i=0; i<100; i++) {
+    pq.push(i, 1000 + (int)((i * 37) % 100));
+  }
+  BOOST_CHECK(pq.size()==100);
+  BOOST_CHECK(pq.top_key()==1000);
+  BOOST_CHECK(pq.top_id()==0);
+  pq.decrease_key(50, 5);
+  BOOST_CHECK(pq.top_id()==50);
+  BOOST_CHECK(pq.key(50)==5);
+  pq.update(50, 2000);
+  BOOST_CHECK(pq.top_id()==0);
+  pq.push(70, 1);
+  BOOST_CHECK(pq.top_id()==70);
+  pq.erase(70);
+  BOOST_CHECK(!pq.contains(70));
+  BOOST_CHECK_THROW(pq.key(70), boost::exceptions::out_of_bounds);
+  BOOST_CHECK(pq.size()==99);
+  int last = -1;
+  while (!pq.empty()) {
+    BOOST_CHECK(pq.top_key() >= last);
+    last = pq.top_key();
+    BOOST_CHECK(pq.key(pq.top_id())==last);
+    pq.pop();
+  }
+  BOOST_CHECK(last==2000);
+  BOOST_CHECK(!pq.contains(0));
+}
@@ -0,0 +1,114 @@
+#include "recycling_allocator.hpp"
+#include "vector.hpp"
+#include "devector_project/devector.hpp"
+#include <string>
+#include <thread>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleRecyclingAllocator
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for recycling_allocator and its thread_local recycling_cache
+ */
+
+//Tests the size classes and that a released buffer is handed out again for any request of its class
+BOOST_AUTO_TEST_CASE(recycling_allocator_size_classes) {
+  boost::recycling_cache& cache = boost::recycling_cache::local();
+  cache.trim();
+  BOOST_CHECK(boost::recycling_cache::size_class(1)==6);
+  BOOST_CHECK(boost::recycling_cache::size_class(64)==6);
+  BOOST_CHECK(boost::recycling_cache::size_class(65)==7);
+  BOOST_CHECK(boost::recycling_cache::size_class(4096)==12);
+  boost::recycling_allocator<int> a;
+  BOOST_CHECK(a.allocate(0)==NULL);
+  int* p = a.allocate(100); //400 bytes, class 512
+  for (int i=0; i<100; i++) {
+    p[i] = i;
+  }
+  a.deallocate(p, 100);
+  BOOST_CHECK(cache.cached_bytes()==512);
+  unsigned long long hits = cache.hits();
+  boost::recycling_allocator<int>::rebind<double>::other b(a);
+  double* q = b.allocate(40); //320 bytes, class 512
+  BOOST_CHECK((void*)q==(void*)p);
+  BOOST_CHECK(cache.hits()==hits + 1);
+  BOOST_CHECK(cache.cached_bytes()==0);
+  b.deallocate(q, 40);
+  //requests over the limit are never cached
+  char* big = boost::recycling_allocator<char>().allocate(RECYCLING_CACHE_MAX_BYTES + 1);
+  boost::recycling_allocator<char>().deallocate(big, RECYCLING_CACHE_MAX_BYTES + 1);
+  BOOST_CHECK(cache.cached_bytes()==512);
+  //only RECYCLING_CACHE_PER_CLASS buffers are kept per class
+  int* buffers[RECYCLING_CACHE_PER_CLASS + 2];
+  for (int i=0; i<RECYCLING_CACHE_PER_CLASS + 2; i++) {
+    buffers[i] = a.allocate(1000);
+  }
+  for (int i=0; i<RECYCLING_CACHE_PER_CLASS + 2; i++) {
+    a.deallocate(buffers[i], 1000);
+  }
+  BOOST_CHECK(cache.cached_bytes()==512 + RECYCLING_CACHE_PER_CLASS * 4096);
+  cache.trim();
+  BOOST_CHECK(cache.cached_bytes()==0);
+}
+
+//Tests that a scratch vector rebuilt on every batch only calls operator new on the first one
+BOOST_AUTO_TEST_CASE(recycling_allocator_scratch_vectors) {
+  boost::recycling_cache& cache = boost::recycling_cache::local();
+  cache.trim();
+  unsigned long long misses = 0;
+  for (int batch=0; batch<5; batch++) {
+    boost::vector<std::string, boost::recycling_allocator<std::string> > scratch;
+    boost::devector<int, boost::recycling_allocator<int> > ids;
+    for (int i=0; i<1000; i++) {
+      scratch.pre_push_back();
+      scratch.push_back(std::to_string(i));
+      ids.push_front(i);
+    }
+    BOOST_CHECK(scratch[999]=="999" && ids[0]==999);
+    if (batch == 0)
+      misses = cache.misses();
+  }
+  BOOST_CHECK(misses > 0);
+  BOOST_CHECK(cache.misses()==misses);
+  BOOST_CHECK(cache.hits() > 0);
+}
+
+//Tests that every thread has its own cache, and that buffers may be released on another thread
+BOOST_AUTO_TEST_CASE(recycling_allocator_threads) {
+  boost::recycling_cache::local().trim();
+  boost::recycling_allocator<char> a;
+  char* p = a.allocate(1000);
+  std::size_t other_cached = 0;
+  std::thread t([&]() {
+    a.deallocate(p, 1000);
+    other_cached = boost::recycling_cache::local().cached_bytes();
+  });
+  t.join();
+  BOOST_CHECK(other_cached==1024);
+  BOOST_CHECK(boost::recycling_cache::local().cached_bytes()==0);
+}
+
+/*
+  Owns a recycling vector and records, when it's destroyed, whether the cache of its thread was already gone
+ */
+static bool cache_closed_at_owner_exit = false;
+struct late_owner {
+  boost::vector<int, boost::recycling_allocator<int> > v;
+  ~late_owner() {
+    cache_closed_at_owner_exit = boost::recycling_cache::closed();
+  }
+};
+
+//Tests that a thread_local container destroyed after the cache of its thread frees its buffer directly
+BOOST_AUTO_TEST_CASE(recycling_allocator_outlives_cache) {
+  std::thread t([]() {
+    //constructed before the cache (an empty vector allocates nothing), so destroyed after it
+    static thread_local late_owner owner;
+    for (int i=0; i<1000; i++) {
+      owner.v.pre_push_back();
+      owner.v.push_back(i);
+    }
+  });
+  t.join();
+  BOOST_CHECK(cache_closed_at_owner_exit);
+  BOOST_CHECK(!boost::recycling_cache::closed());
+}
@@ -0,0 +1,121 @@
+#include "snapshot_vector.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+#define BOOST_TEST_DYN_LYNK
+#define BOOST_TEST_MODULE BoostExampleSnapshotVector
+#include <boost/test/included/unit_test.hpp>
+/*
+  This file includes unit tests for snapshot_vector
+ */
+
+//Element type that counts its live instances, to check that retired buffers are reclaimed
+struct counted {
+  static std::atomic<int> live;
+  int value;
+  counted() : value(0) { live++; }
+  counted(int v) : value(v) { live++; }
+  counted(const counted& other) : value(other.value) { live++; }
+  ~counted() { live--; }
+};
+std::atomic<int> counted::live(0);
+
+//Tests that a snapshot keeps its size and elements while the writer appends and grows
+BOOST_AUTO_TEST_CASE(snapshot_vector_int_snapshot_is_immutable) {
+  boost::snapshot_vector<int> v;
+  BOOST_CHECK(v.read().empty());
+  for (int i=0; i<10; i++) {
+    v.push_back(i);
+  }
+  boost::snapshot_vector<int>::snapshot s = v.read();
+  BOOST_CHECK(s.size()==10);
+  for (int i=10; i<1000; i++) {
+    v.push_back(i);
+  }
+  BOOST_CHECK(v.size()==1000);
+  BOOST_CHECK(s.size()==10);
+  for (int i=0; i<10; i++) {
+    BOOST_CHECK(s[i]==i);
+  }
+  BOOST_CHECK_THROW(s[10], boost::exceptions::out_of_bounds);
+
+  boost::snapshot_vector<int>::snapshot s2 = v.read();
+  BOOST_CHECK(s2.size()==1000);
+  int expected = 0;
+  for (boost::snapshot_vector<int>::const_iterator it = s2.begin(); it != s2.end(); ++it) {
+    BOOST_CHECK(*it==expected++);
+  }
+  v.clear();
+  BOOST_CHECK(v.read().empty());
+  BOOST_CHECK(s2.size()==1000);
+  BOOST_CHECK(s2[999]==999);
+}
+
+//Tests that retired buffers are freed once the last snapshot referencing them is released
+BOOST_AUTO_TEST_CASE(snapshot_vector_reclamation) {
+  {
+    boost::snapshot_vector<counted>::snapshot outliving;
+    {
+      boost::snapshot_vector<counted> v;
+      boost::snapshot_vector<counted>::snapshot s;
+      for (int i=0; i<100; i++) {
+        v.push_back(counted(i));
+        if (i == 9) {
+          boost::snapshot_vector<counted>::snapshot copy = v.read();
+          s = copy;
+        }
+      }
+      //only the published buffer and the one s references (filled up to its capacity of 16) are alive
+      BOOST_CHECK(s.size()==10);
+      BOOST_CHECK(counted::live==100 + 16);
+      s = boost::snapshot_vector<counted>::snapshot();
+      BOOST_CHECK(counted::live==100);
+      outliving = v.read();
+      for (int i=0; i<100000; i++) {
+        v.read(); //enough snapshots to fold the external count several times
+      }
+    }
+    BOOST_CHECK(counted::live==100);
+    BOOST_CHECK(outliving[99].value==99);
+  }
+  BOOST_CHECK(counted::live==0);
+}
+
+//Tests string elements, which are copied to the new buffer on growth
+BOOST_AUTO_TEST_CASE(snapshot_vector_string) {
+  boost::snapshot_vector<std::string> v;
+  v.push_back("abc");
+  boost::snapshot_vector<std::string>::snapshot s = v.read();
+  v.push_back("def");
+  v.push_back("wahttheguck");
+  BOOST_CHECK(s.size()==1 && s[0]=="abc");
+  BOOST_CHECK(v[2]=="wahttheguck");
+  BOOST_CHECK(v.read()[1]=="def");
+}
+
+//Tests concurrent readers while one writer appends: every snapshot must be a consistent prefix
+BOOST_AUTO_TEST_CASE(snapshot_vector_concurrent_readers) {
+  const int n = 200000;
+  boost::snapshot_vector<int> v;
+  std::atomic<bool> done(false);
+  std::atomic<int> errors(0);
+  std::vector<std::thread> readers;
+  for (int r=0; r<4; r++) {
+    readers.push_back(std::thread([&]() {
+      while (!done.load()) {
+        boost::snapshot_vector<int>::snapshot s = v.read();
+        if (!s.empty() && (s.data()[0] != 0 || s.data()[s.size()-1] != (int)s.size()-1))
+          errors++;
+      }
+    }));
+  }
+  for (int i=0; i<n; i++) {
+    v.push_back(i);
+  }
+  done = true;
+  for (size_t r=0; r<readers.size(); r++) {
+    readers[r].join();
+  }
+  BOOST_CHECK(errors==0);
+  BOOST_CHECK(v.read().size()==(unsigned)n);
+}
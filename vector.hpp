@@ -23,12 +23,18 @@
 
 //Memory is used to include std::allocator, in theory, we can use any allocator who gives us contiguous memory blocks of the size we request
 #include <memory>
-//We include cstring for memcpy
-#include <cstring>
 //We include exception for stl exceptions
 #include <exception>
 //We include initializer_list due to their awesome flying cows
 #include <initializer_list>
+//We include release_pages for the madvise based automatic shrink
+#include "release_pages.hpp"
+//We include aligned_allocator for the aligned_vector shorthand
+#include "aligned_allocator.hpp"
+//We include relocate to move the elements to a new buffer (memcpy, move or copy, depending on T), and for default_init
+#include "relocate.hpp"
+//We include span for append_uninitialized
+#include "span.hpp"
 
 /*
   These are the constants for the amortized time push_back.
@@ -41,9 +47,44 @@
     (INC,MULT) = (1,0) would give us the time O(n^2) but with list-like memory eficiency
   and:
     (INC,MULT) = (1,1.6f) would give us a vector like the Dinkumware implementation (Visual Studio)
+  Both can be set from the command line (e.g. -DVECTOR_AMORT_INC=1 -DVECTOR_AMORT_MULT=1.5f), as the benchmarks do.
  */
+#ifndef VECTOR_AMORT_INC
 #define VECTOR_AMORT_INC 0
+#endif
+#ifndef VECTOR_AMORT_MULT
 #define VECTOR_AMORT_MULT 2
+#endif
+
+/*
+  These are the constants for the automatic shrink.
+  whenever pop_back leaves the vector with less than (capacity / SHRINK_DIV) elements, its capacity is reduced to
+  (size * SHRINK_MULT) elements. With SHRINK_DIV > SHRINK_MULT this has hysteresis: after a shrink the vector has to
+  lose another (SHRINK_DIV / SHRINK_MULT) of its elements before shrinking again, or to grow by SHRINK_MULT before
+  it reallocates again, so alternating pushes and pops around the threshold don't thrash.
+
+  Buffers smaller than SHRINK_MIN_BYTES are never shrunk automatically, nor below that size.
+  Buffers of at least SHRINK_MADVISE_BYTES are not reallocated: the pages past (size * SHRINK_MULT) elements are
+  handed back to the OS instead (see release_pages.hpp), which copies nothing and keeps the capacity.
+
+  The shrink never goes below the capacity asked for with vector(n) or reserve(n): push_back doesn't grow the vector,
+  so a caller that reserved once and then pushes and pops in cycles must still find that room after popping.
+
+  The automatic shrink is opt in: SHRINK_DIV = 0 (the default) disables it, set it from the command line
+  (e.g. -DVECTOR_SHRINK_DIV=4) to enable it.
+ */
+#ifndef VECTOR_SHRINK_DIV
+#define VECTOR_SHRINK_DIV 0
+#endif
+#ifndef VECTOR_SHRINK_MULT
+#define VECTOR_SHRINK_MULT 2
+#endif
+#ifndef VECTOR_SHRINK_MIN_BYTES
+#define VECTOR_SHRINK_MIN_BYTES 4096
+#endif
+#ifndef VECTOR_SHRINK_MADVISE_BYTES
+#define VECTOR_SHRINK_MADVISE_BYTES (1 << 20)
+#endif
 
 namespace boost {
   namespace exceptions
@@ -101,6 +142,8 @@ namespace boost {
       try {
         m_capacity = 0;
         m_size = 0;
+        m_trimmed = 0;
+        m_reserved = 0;
         m_buffer = m_allocator.allocate(m_capacity);
       }  catch (const std::exception& e) {
         m_capacity = 0;
@@ -112,6 +155,8 @@ namespace boost {
       try {
         m_capacity = n; 
         m_size = 0;
+        m_trimmed = 0;
+        m_reserved = n;
         m_buffer = m_allocator.allocate(m_capacity);
       }  catch (const std::exception& e) {
         m_capacity = 0;
@@ -124,6 +169,8 @@ namespace boost {
       size_type i=0;
       m_capacity = l.size();
       m_size = l.size();
+      m_trimmed = 0;
+      m_reserved = 0;
       try {
         m_buffer = m_allocator.allocate(m_capacity);
       } catch (const std::exception& e) {
@@ -185,17 +232,25 @@ namespace boost {
       value_type * pre_buffer;
       if (n<0) throw exceptions::invalid_size();
       if (n < m_capacity) {
+        size_type kept = (m_size < n ? m_size : n);
         pre_buffer = m_allocator.allocate(n); 
-        memcpy(pre_buffer, m_buffer, ((byte*)(m_buffer + n)) - ((byte*)m_buffer));
-        for (size_type i=n; i<m_size; i++) {
+        try {
+          relocate(m_allocator, m_buffer, m_buffer + kept, pre_buffer);
+        } catch (...) {
+          m_allocator.deallocate(pre_buffer, n);
+          throw;
+        }
+        for (size_type i=kept; i<m_size; i++) {
           m_allocator.destroy(m_buffer + i);
         }
         m_allocator.deallocate(m_buffer, m_capacity);
         m_buffer = pre_buffer;
         m_capacity = n;
+        m_trimmed = 0;
+        m_reserved = (m_reserved < n ? m_reserved : n); //the caller gave the rest back
         m_size = (m_size < n ? m_size : n);
       } else if (n > m_capacity) {
-        reserve(n);
+        priv_reserve(n);
         //from now on we can only hold weak guarantee:
         try {
           for (i=m_size; i<n; i++) {
@@ -211,6 +266,25 @@ namespace boost {
       }
     }
 
+    /*
+      Like resize, but the new elements are default initialized instead of value initialized: trivial types (char,
+      int, PODs) are left uninitialized, so growing a byte buffer doesn't zero it first.
+      Unlike resize, the capacity is only ever grown (to exactly n), and shrinking just destroys the last elements.
+      Strong guarantee
+     */
+    void resize_default_init(size_type n) {
+      if (n < m_size) {
+        for (size_type i=n; i<m_size; i++) {
+          m_allocator.destroy(m_buffer + i);
+        }
+        m_size = n;
+      } else if (n > m_size) {
+        priv_reserve(n);
+        default_init(m_buffer + m_size, m_buffer + n);
+        m_size = n;
+      }
+    }
+
     size_type capacity() const noexcept {
       return m_capacity;
     }
@@ -223,19 +297,12 @@ namespace boost {
       resize(m_size);
     }
 
+    /*
+      Makes room for at least n elements. The automatic shrink keeps this room. Strong guarantee
+     */
     void reserve(size_type n) {
-      value_type * pre_buffer;
-      if (n > m_capacity) {
-        try {
-          pre_buffer = m_allocator.allocate(n);
-        } catch (const std::exception& e) {
-          throw e;
-        }
-        memcpy(pre_buffer, m_buffer, ((byte*)(m_buffer + m_size)) - ((byte*)m_buffer));
-        m_allocator.deallocate(m_buffer, m_capacity);
-        m_buffer = pre_buffer;
-        m_capacity = n;
-      }
+      priv_reserve(n);
+      m_reserved = (m_reserved > n ? m_reserved : n);
     }
 
   /*
@@ -273,9 +340,9 @@ namespace boost {
     void pre_push_back() {
       if(m_capacity <= m_size) {
         if ((m_size+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT) != 0)
-          reserve((m_size+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
+          priv_reserve((m_size+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT)); //Throws if reserve throws
         else
-          reserve(1);
+          priv_reserve(1);
       }
     }
     
@@ -288,14 +355,57 @@ namespace boost {
       m_size++;
     }
 
+    void push_back(T&& x) {
+      if(m_capacity <= m_size) {
+        throw exceptions::buffer_overflow();
+      }
+      m_allocator.construct(m_buffer + m_size, std::move(x));
+      m_size++;
+    }
+
+    /*
+      Returns the n elements past the end as a writable span of raw memory, growing the buffer (geometrically, as
+      pre_push_back does) if they don't fit. size() doesn't change until commit(k) adopts the first k of them, e.g.
+        ssize_t k = read(fd, v.append_uninitialized(4096).data(), 4096);
+        v.commit(k > 0 ? k : 0);
+      Only for trivial types, whose objects need no construction. A span that wasn't committed yet is invalidated by
+      any reallocation.
+     */
+    span<T> append_uninitialized(size_type n) {
+      static_assert(std::is_trivial<T>::value, "append_uninitialized needs a trivial value_type");
+      if (m_capacity - m_size < n) {
+        size_type grown = (m_size+VECTOR_AMORT_INC) * (VECTOR_AMORT_MULT);
+        priv_reserve(m_size + n > grown ? m_size + n : grown); //Throws if reserve throws
+      }
+      return span<T>(m_buffer + m_size, n);
+    }
+
+    /*
+      Adopts the first k elements past the end (written through append_uninitialized) as elements
+     */
+    void commit(size_type k) {
+      static_assert(std::is_trivial<T>::value, "commit needs a trivial value_type");
+      if (k > m_capacity - m_size)
+        throw exceptions::buffer_overflow();
+      m_size += k;
+    }
+
     void pop_back() {
       if (empty())
         throw exceptions::out_of_bounds();
       m_allocator.destroy(m_buffer + --m_size);
+      priv_auto_shrink();
     }
 
-    void clear() {//we could rewrite part of resize in here to make this noexcept, but that would be overkill for this example
-      resize(0);
+    /*
+      Destroys every element but keeps the buffer, as std::vector does, so refilling the vector doesn't go through
+      the whole allocate and grow sequence again. shrink_to_fit (or swapping with an empty vector) gives it back
+     */
+    void clear() noexcept {
+      for (size_type i=0; i<m_size; i++) {
+        m_allocator.destroy(m_buffer + i);
+      }
+      m_size = 0;
     }
 
    
@@ -304,10 +414,80 @@ namespace boost {
     size_type m_capacity;
     Alloc m_allocator;
     T* m_buffer;
+    size_type m_trimmed; //pages past m_buffer + m_trimmed were released to the OS (0 if none were)
+    size_type m_reserved; //capacity asked for with vector(n) or reserve(n), which the automatic shrink keeps
+
+    /*
+      Grows the buffer to exactly n elements if it's smaller. Strong guarantee
+     */
+    void priv_reserve(size_type n) {
+      value_type * pre_buffer;
+      if (n > m_capacity) {
+        try {
+          pre_buffer = m_allocator.allocate(n);
+        } catch (const std::exception& e) {
+          throw e;
+        }
+        try {
+          relocate(m_allocator, m_buffer, m_buffer + m_size, pre_buffer);
+        } catch (...) {
+          m_allocator.deallocate(pre_buffer, n);
+          throw;
+        }
+        m_allocator.deallocate(m_buffer, m_capacity);
+        m_buffer = pre_buffer;
+        m_capacity = n;
+        m_trimmed = 0;
+      }
+    }
+
+    /*
+      Applies the automatic shrink policy after an element was removed. Never throws: if the smaller buffer can't be
+      allocated the vector simply keeps the bigger one.
+     */
+    void priv_auto_shrink() noexcept {
+#if VECTOR_SHRINK_DIV != 0
+      if ((std::size_t)m_capacity * sizeof(T) < VECTOR_SHRINK_MIN_BYTES)
+        return;
+      if (m_size + 1 > m_trimmed) //the released pages were written to again since the last shrink
+        m_trimmed = 0;
+      size_type watermark = (m_trimmed != 0 ? m_trimmed : m_capacity);
+      if (m_size >= watermark / VECTOR_SHRINK_DIV)
+        return;
+      size_type target = m_size * VECTOR_SHRINK_MULT;
+      if ((std::size_t)target * sizeof(T) < VECTOR_SHRINK_MIN_BYTES)
+        target = VECTOR_SHRINK_MIN_BYTES / sizeof(T);
+      if (target < 1)
+        target = 1;
+      if (target < m_reserved)
+        target = m_reserved;
+      if (target >= watermark)
+        return;
+      if (can_release_pages<Alloc>::value && (std::size_t)m_capacity * sizeof(T) >= VECTOR_SHRINK_MADVISE_BYTES) {
+        detail::release_pages(m_buffer + target, m_buffer + m_capacity);
+        m_trimmed = target;
+      } else {
+        value_type * pre_buffer = NULL;
+        try {
+          pre_buffer = m_allocator.allocate(target);
+          relocate(m_allocator, m_buffer, m_buffer + m_size, pre_buffer);
+        } catch (...) {
+          if (pre_buffer != NULL)
+            m_allocator.deallocate(pre_buffer, target);
+          return;
+        }
+        m_allocator.deallocate(m_buffer, m_capacity);
+        m_buffer = pre_buffer;
+        m_capacity = target;
+        m_trimmed = 0;
+      }
+#endif
+    }
 
   };
 
-  
+  template <typename T, std::size_t Align = 64>
+  using aligned_vector = vector<T, aligned_allocator<T, Align> >;
 };
 
 